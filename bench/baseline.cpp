@@ -0,0 +1,282 @@
+#include "bench.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace ev_sim {
+namespace bench {
+
+namespace {
+
+/**
+ * Just enough JSON to read a results file back: values are parsed
+ * recursively, and only the fields of "results" entries are kept
+ */
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text_(text), pos_(0) {}
+
+    bool readResults(std::vector<BaselineEntry>& entries, std::string& error) {
+        skipSpace();
+        if (!consume('{')) {
+            return fail(error, "expected an object");
+        }
+        bool found = false;
+        while (!consume('}')) {
+            std::string key;
+            if (!readString(key) || !consume(':')) {
+                return fail(error, "malformed object key");
+            }
+            if (key == "results") {
+                if (!readResultArray(entries)) {
+                    return fail(error, "malformed \"results\" array");
+                }
+                found = true;
+            } else if (!skipValue()) {
+                return fail(error, "malformed value for \"" + key + "\"");
+            }
+            consume(',');
+        }
+        if (!found) {
+            return fail(error, "no \"results\" array");
+        }
+        return true;
+    }
+
+private:
+    bool readResultArray(std::vector<BaselineEntry>& entries) {
+        if (!consume('[')) {
+            return false;
+        }
+        while (!consume(']')) {
+            if (!consume('{')) {
+                return false;
+            }
+            BaselineEntry entry = { "", 0.0, -1.0, -1.0 };
+            while (!consume('}')) {
+                std::string key;
+                if (!readString(key) || !consume(':')) {
+                    return false;
+                }
+                bool ok;
+                if (key == "name") {
+                    ok = readString(entry.name);
+                } else if (key == "ns_per_op") {
+                    ok = readNumber(entry.ns_per_op);
+                } else if (key == "ci_low_ns") {
+                    ok = readNumber(entry.ci_low_ns);
+                } else if (key == "ci_high_ns") {
+                    ok = readNumber(entry.ci_high_ns);
+                } else {
+                    ok = skipValue();
+                }
+                if (!ok) {
+                    return false;
+                }
+                consume(',');
+            }
+            // Files from single-repetition runs have no interval
+            if (entry.ci_low_ns < 0.0) entry.ci_low_ns = entry.ns_per_op;
+            if (entry.ci_high_ns < 0.0) entry.ci_high_ns = entry.ns_per_op;
+            if (!entry.name.empty() && entry.ns_per_op > 0.0) {
+                entries.push_back(entry);
+            }
+            consume(',');
+        }
+        return true;
+    }
+
+    bool skipValue() {
+        skipSpace();
+        if (pos_ >= text_.size()) {
+            return false;
+        }
+        const char c = text_[pos_];
+        if (c == '"') {
+            std::string ignored;
+            return readString(ignored);
+        }
+        if (c == '{' || c == '[') {
+            const char close = c == '{' ? '}' : ']';
+            pos_++;
+            while (!consume(close)) {
+                if (c == '{') {
+                    std::string key;
+                    if (!readString(key) || !consume(':')) {
+                        return false;
+                    }
+                }
+                if (!skipValue()) {
+                    return false;
+                }
+                consume(',');
+            }
+            return true;
+        }
+        // Number, true, false or null
+        const size_t start = pos_;
+        while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' && text_[pos_] != ']' &&
+               !std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            pos_++;
+        }
+        return pos_ > start;
+    }
+
+    bool readString(std::string& out) {
+        skipSpace();
+        if (!consume('"')) {
+            return false;
+        }
+        out.clear();
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\' && pos_ < text_.size()) {
+                c = text_[pos_++];
+                if (c == 'n') c = '\n';
+                else if (c == 't') c = '\t';
+                else if (c == 'u') { pos_ = std::min(pos_ + 4, text_.size()); c = '?'; }
+            }
+            out += c;
+        }
+        return consume('"');
+    }
+
+    bool readNumber(double& out) {
+        skipSpace();
+        const char* begin = text_.c_str() + pos_;
+        char* end = nullptr;
+        out = std::strtod(begin, &end);
+        if (end == begin) {
+            return false;
+        }
+        pos_ += static_cast<size_t>(end - begin);
+        return true;
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            pos_++;
+        }
+    }
+
+    // Skip whitespace, then take c if it is next
+    bool consume(char c) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool fail(std::string& error, const std::string& what) const {
+        error = what + " near offset " + std::to_string(pos_);
+        return false;
+    }
+
+    const std::string& text_;
+    size_t pos_;
+};
+
+} // namespace
+
+SampleStats summarizeSamples(std::vector<double> samples) {
+    SampleStats stats = { 0.0, 0.0, 0.0 };
+    const size_t n = samples.size();
+    if (n == 0) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    stats.median = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+
+    if (n < 6) {
+        // Too few samples for the order-statistic interval
+        stats.ci_low = samples.front();
+        stats.ci_high = samples.back();
+        return stats;
+    }
+    // 1-based ranks j = n/2 - 1.96 * sqrt(n) / 2 and k = 1 + n/2 + 1.96 * sqrt(n) / 2, rounded
+    // (normal approximation to the binomial; n = 10 gives ranks 2 and 9), read at 0-based j - 1 and k - 1
+    const double half_width = 0.98 * std::sqrt(static_cast<double>(n));
+    const long low = std::lround(n / 2.0 - half_width) - 1;
+    const long high = std::lround(1.0 + n / 2.0 + half_width) - 1;
+    stats.ci_low = samples[static_cast<size_t>(std::max(low, 0L))];
+    stats.ci_high = samples[static_cast<size_t>(std::min(high, static_cast<long>(n) - 1))];
+    return stats;
+}
+
+bool loadBaseline(const std::string& path, std::vector<BaselineEntry>& entries, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    entries.clear();
+    JsonReader reader(text);
+    return reader.readResults(entries, error);
+}
+
+std::vector<Comparison> compareToBaseline(const std::vector<BenchResult>& results,
+                                          const std::vector<BaselineEntry>& baseline,
+                                          double threshold_percent) {
+    std::map<std::string, const BaselineEntry*> by_name;
+    for (const BaselineEntry& entry : baseline) {
+        by_name[entry.name] = &entry;
+    }
+
+    std::vector<Comparison> comparisons;
+    for (const BenchResult& result : results) {
+        auto it = by_name.find(result.name);
+        if (it == by_name.end()) {
+            continue;
+        }
+        const BaselineEntry& reference = *it->second;
+
+        Comparison comparison;
+        comparison.name = result.name;
+        comparison.baseline_ns = reference.ns_per_op;
+        comparison.current_ns = result.ns_per_op;
+        comparison.change_percent = (result.ns_per_op / reference.ns_per_op - 1.0) * 100.0;
+        // Both the size of the change and non-overlapping intervals are required,
+        // so neither a tiny shift nor a noisy run alone fails the gate
+        comparison.regressed = comparison.change_percent > threshold_percent &&
+                               result.ci_low_ns > reference.ci_high_ns;
+        comparison.improved = comparison.change_percent < -threshold_percent &&
+                              result.ci_high_ns < reference.ci_low_ns;
+        comparisons.push_back(comparison);
+    }
+    return comparisons;
+}
+
+void printComparison(std::ostream& out, const std::vector<Comparison>& comparisons, double threshold_percent) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "\nBaseline comparison (threshold %.1f%%)\n%-34s %14s %14s %9s\n",
+                  threshold_percent, "benchmark", "baseline ns", "current ns", "change");
+    out << line;
+
+    int regressions = 0;
+    for (const Comparison& comparison : comparisons) {
+        const char* verdict = comparison.regressed ? "REGRESSION" : (comparison.improved ? "improved" : "");
+        std::snprintf(line, sizeof(line), "%-34s %14.1f %14.1f %+8.1f%%  %s\n", comparison.name.c_str(),
+                      comparison.baseline_ns, comparison.current_ns, comparison.change_percent, verdict);
+        out << line;
+        regressions += comparison.regressed ? 1 : 0;
+    }
+
+    if (comparisons.empty()) {
+        out << "No benchmarks in common with the baseline\n";
+    } else {
+        out << regressions << " regression(s) in " << comparisons.size() << " benchmark(s)\n";
+    }
+}
+
+} // namespace bench
+} // namespace ev_sim
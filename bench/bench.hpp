@@ -0,0 +1,237 @@
+#pragma once
+
+#include "perf_counters.hpp"
+#include "tick_monitor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+namespace bench {
+
+/**
+ * One measured benchmark
+ */
+struct BenchResult {
+    std::string name;         // e.g. "physics/engine_update"
+    std::string unit;         // Unit of value, e.g. "steps/s"
+    double value;             // Operations per second (from the median)
+    double ns_per_op;         // Median wall time per operation (ns)
+    double ci_low_ns;         // 95% confidence interval of the median (ns/op)
+    double ci_high_ns;
+    uint64_t iterations;      // Operations per measured batch
+    std::vector<double> samples_ns;  // ns/op of every repetition
+    PerfSample counters;      // Hardware counters over the last batch (if enabled)
+};
+
+/**
+ * Median of a sample set with a distribution-free 95% confidence interval
+ * (order statistics around n/2; the full range below 6 samples)
+ */
+struct SampleStats {
+    double median;
+    double ci_low;
+    double ci_high;
+};
+
+SampleStats summarizeSamples(std::vector<double> samples);
+
+/**
+ * Reference timing of one benchmark, read from a saved results file
+ */
+struct BaselineEntry {
+    std::string name;
+    double ns_per_op;
+    double ci_low_ns;
+    double ci_high_ns;
+};
+
+/**
+ * Read the results of a previous run (the JSON written by writeJson)
+ * @return false with error set if the file is missing or malformed
+ */
+bool loadBaseline(const std::string& path, std::vector<BaselineEntry>& entries, std::string& error);
+
+/**
+ * One benchmark compared against its baseline
+ */
+struct Comparison {
+    std::string name;
+    double baseline_ns;
+    double current_ns;
+    double change_percent;    // Positive = slower
+    bool regressed;           // Slower beyond the threshold with disjoint confidence intervals
+    bool improved;            // Same test in the other direction
+};
+
+/**
+ * Compare results with a baseline; benchmarks missing from either side are skipped
+ * @param threshold_percent Minimum slowdown of the median to count as a regression
+ */
+std::vector<Comparison> compareToBaseline(const std::vector<BenchResult>& results,
+                                          const std::vector<BaselineEntry>& baseline,
+                                          double threshold_percent);
+
+void printComparison(std::ostream& out, const std::vector<Comparison>& comparisons, double threshold_percent);
+
+/**
+ * Keep a value alive so the optimizer cannot drop the work producing it
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * Minimal benchmark runner
+ *
+ * Each benchmark is a batch function taking an iteration count. The runner
+ * grows the batch until one run lasts at least min_time seconds, then
+ * repeats that batch size until it has `repetitions` timings and records
+ * their median. Benchmarks whose name does not contain the filter string
+ * are skipped.
+ */
+class Runner {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Runner(double min_time, int repetitions, const std::string& filter);
+
+    /**
+     * Whether a benchmark passes the name filter
+     */
+    bool enabled(const std::string& name) const;
+
+    /**
+     * Count hardware events around every measured batch
+     * @return false if no counter could be opened (see perfCounters())
+     */
+    bool enablePerfCounters();
+    const PerfCounters* perfCounters() const { return perf_.get(); }
+
+    /**
+     * Calibrate and measure a batch function
+     * @param name Benchmark name
+     * @param unit Unit reported for the ops/s value
+     * @param batch Callable as batch(uint64_t iterations)
+     */
+    template <typename Batch>
+    void run(const std::string& name, const char* unit, Batch&& batch);
+
+    const std::vector<BenchResult>& results() const { return results_; }
+
+    /**
+     * Print a human-readable table
+     */
+    void printTable(std::ostream& out) const;
+
+    /**
+     * Write all results as JSON
+     */
+    void writeJson(std::ostream& out) const;
+
+private:
+    template <typename Batch>
+    double measure(Batch& batch, uint64_t iterations, PerfSample& counters);
+
+    void record(const std::string& name, const char* unit, uint64_t iterations,
+                const std::vector<double>& samples_ns, const PerfSample& counters);
+
+    double min_time_;
+    int repetitions_;
+    std::string filter_;
+    std::unique_ptr<PerfCounters> perf_;
+    std::vector<BenchResult> results_;
+};
+
+template <typename Batch>
+double Runner::measure(Batch& batch, uint64_t iterations, PerfSample& counters) {
+    if (perf_) perf_->start();
+    const Clock::time_point start = Clock::now();
+    batch(iterations);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    counters = perf_ ? perf_->stop() : PerfSample();
+    return seconds;
+}
+
+template <typename Batch>
+void Runner::run(const std::string& name, const char* unit, Batch&& batch) {
+    if (!enabled(name)) {
+        return;
+    }
+
+    batch(1);  // Warm caches and lazy initialization
+
+    uint64_t iterations = 1;
+    PerfSample counters;
+    for (;;) {
+        const double seconds = measure(batch, iterations, counters);
+
+        if (seconds >= min_time_ || iterations >= (uint64_t(1) << 40)) {
+            // The calibrated run is the first repetition
+            std::vector<double> samples_ns(1, seconds * 1e9 / iterations);
+            while (static_cast<int>(samples_ns.size()) < repetitions_) {
+                samples_ns.push_back(measure(batch, iterations, counters) * 1e9 / iterations);
+            }
+            record(name, unit, iterations, samples_ns, counters);
+            return;
+        }
+
+        // Aim 20% past the target, growing at most 10x per attempt
+        uint64_t next = iterations * 10;
+        if (seconds > 0.0) {
+            next = std::min(next, static_cast<uint64_t>(iterations * min_time_ * 1.2 / seconds) + 1);
+        }
+        iterations = std::max(next, iterations * 2);
+    }
+}
+
+// Benchmark groups
+void runPhysicsBenchmarks(Runner& runner);
+void runUiBenchmarks(Runner& runner);
+
+/**
+ * Accuracy vs. CPU cost of each EngineIntegrator over a range of time steps,
+ * against a fine-step RK4 reference; names the cheapest configuration whose
+ * worst RPM error stays within tolerance_rpm
+ */
+void runIntegratorStudy(std::ostream& out, double tolerance_rpm);
+
+/**
+ * Couple the clutch through a fixed pedal sequence with each solver over a
+ * range of time steps and print the transmission RPM error against a
+ * fine-step analytic reference; then the same for the friction clutch with
+ * and without in-step event detection, including lock-up timing
+ */
+void runClutchStudy(std::ostream& out);
+
+/**
+ * Settings for the real-time tick check
+ */
+struct RealtimeOptions {
+    double seconds = 10.0;    // Wall-clock duration
+    double tick_hz = 10.0;    // Physics rate (the dashboard runs at 10 Hz)
+    float bin_ms = 0.5f;      // Lateness histogram bin width
+    TickSla sla;
+};
+
+/**
+ * Step the drivetrain against the wall clock with the dashboard's tick
+ * scheduler and check tick lateness against an SLA
+ * @param report Receives the summary and lateness histogram
+ * @param json_path Optional JSON output file
+ * @return true if the SLA was met
+ */
+bool runRealtimeCheck(const RealtimeOptions& options, std::ostream& report, const std::string& json_path);
+
+} // namespace bench
+} // namespace ev_sim
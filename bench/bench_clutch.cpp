@@ -0,0 +1,239 @@
+#include "bench.hpp"
+#include "clutch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ev_sim {
+namespace bench {
+
+namespace {
+
+constexpr double kSegmentSeconds = 0.5;   // Engagement changes every half second
+constexpr int kSegments = 12;             // 6 s of pedal work
+constexpr double kReferenceDt = 1e-4;
+constexpr float kEngineInertia = 0.1f;    // Friction scenario engine side (kg⋅m²)
+
+// Pedal sequence of the blending scenario, repeated
+const float kEngagement[6] = { 0.1f, 0.25f, 0.0f, 0.5f, 1.0f, 0.0f };
+
+/**
+ * Couple a spinning engine to a stopped transmission through a sequence of
+ * pedal positions and sample the transmission RPM at the end of every
+ * segment. The engine is not driven so only the clutch solver is compared.
+ */
+void simulate(ClutchSolver solver, double dt, float* trans_samples) {
+    Clutch clutch;
+    clutch.setSolver(solver);
+    float engine_rpm = 3000.0f;
+    float trans_rpm = 0.0f;
+    const int steps_per_segment = static_cast<int>(std::lround(kSegmentSeconds / dt));
+    for (int s = 0; s < kSegments; s++) {
+        // Re-open the gap after each locked phase so every segment has work to do
+        if (s % 6 == 0) {
+            engine_rpm = 3000.0f + 500.0f * (s / 6);
+        }
+        for (int i = 0; i < steps_per_segment; i++) {
+            clutch.update(engine_rpm, trans_rpm, kEngagement[s % 6], static_cast<float>(dt));
+        }
+        trans_samples[s] = trans_rpm;
+    }
+}
+
+/**
+ * The blending scenario with the Analytic solver's formulas in double,
+ * through the templated core
+ */
+void simulateReference(double dt, double* trans_samples) {
+    const double stiffness = Clutch().getStiffness();
+    double engine_rpm = 3000.0;
+    double trans_rpm = 0.0;
+    const int steps_per_segment = static_cast<int>(std::lround(kSegmentSeconds / dt));
+    for (int s = 0; s < kSegments; s++) {
+        if (s % 6 == 0) {
+            engine_rpm = 3000.0 + 500.0 * (s / 6);
+        }
+        const double engagement = kEngagement[s % 6];
+        for (int i = 0; i < steps_per_segment; i++) {
+            if (engagement == 0.0) {
+                trans_rpm = std::max(trans_rpm * physics::coastFactor(dt, true), 0.0);
+            } else {
+                const double convergence = physics::clutchConvergence(engagement, stiffness, dt, true);
+                physics::clutchCouple(engine_rpm, trans_rpm, convergence, 0.5);
+            }
+        }
+        trans_samples[s] = trans_rpm;
+    }
+}
+
+/**
+ * Friction scenario segment: pedal and the engine's free acceleration
+ */
+struct FrictionSegment {
+    float engagement;
+    float engine_accel;      // RPM/s with the clutch open
+};
+
+// Slip-up from rest, lock-up, breakaway under a rev burst with the pedal
+// nearly in, re-lock, then a lift-off that the static capacity holds
+const FrictionSegment kFrictionScenario[] = {
+    { 0.02f, 150.0f }, { 0.05f, 150.0f }, { 0.3f, 150.0f }, { 0.01f, 900.0f },
+    { 0.1f, 300.0f }, { 1.0f, -400.0f }, { 0.0f, -200.0f }, { 0.04f, 0.0f },
+};
+constexpr int kFrictionSegments = static_cast<int>(sizeof(kFrictionScenario) / sizeof(kFrictionScenario[0]));
+
+struct FrictionRun {
+    double trans_rpm[kFrictionSegments];
+    double event_times[32];  // Lock-ups and breakaways (s from start)
+    int events;
+};
+
+/**
+ * Drive the friction clutch through the scenario. With event_detection
+ * off, the regime is only re-evaluated at step boundaries (kinetic torque
+ * signed by the current slip), which is what a plain fixed-step model does.
+ */
+void simulateFriction(bool event_detection, double dt, FrictionRun& run) {
+    Clutch clutch;
+    clutch.setSolver(ClutchSolver::Friction);
+    float engine_rpm = 3000.0f;
+    float trans_rpm = 0.0f;
+    run.events = 0;
+    const int steps_per_segment = static_cast<int>(std::lround(kSegmentSeconds / dt));
+    for (int s = 0; s < kFrictionSegments; s++) {
+        const FrictionSegment& segment = kFrictionScenario[s];
+        for (int i = 0; i < steps_per_segment; i++) {
+            const float trans_accel = -Clutch::kCoastDecayRate * trans_rpm;
+            if (event_detection) {
+                const bool was_locked = clutch.isLocked();
+                clutch.updateFriction(engine_rpm, trans_rpm, segment.engine_accel, trans_accel, kEngineInertia,
+                                      segment.engagement, static_cast<float>(dt));
+                if (clutch.isLocked() != was_locked && run.events < 32) {
+                    const double within = clutch.getEventTime() >= 0.0f ? clutch.getEventTime() : 0.0;
+                    run.event_times[run.events++] = (s * steps_per_segment + i) * dt + within;
+                }
+            } else {
+                const float slip = engine_rpm - trans_rpm;
+                float torque = segment.engagement * clutch.getKineticCapacity();
+                torque = slip >= 0.0f ? torque : -torque;
+                const float k = 60.0f / (2.0f * 3.14159265f);
+                engine_rpm += (segment.engine_accel - torque * k / kEngineInertia) * static_cast<float>(dt);
+                trans_rpm += (trans_accel + torque * k / clutch.getDrivenInertia()) * static_cast<float>(dt);
+                trans_rpm = std::max(trans_rpm, 0.0f);
+            }
+        }
+        run.trans_rpm[s] = trans_rpm;
+    }
+}
+
+/**
+ * The scenario in double precision through the templated friction core,
+ * with the default clutch's parameters, so float rounding in the runs
+ * under test does not swamp their solver error
+ */
+void simulateFrictionReference(double dt, FrictionRun& run) {
+    const Clutch clutch;
+    const double engine_gain = physics::kRadPerSecToRPM / static_cast<double>(kEngineInertia);
+    const double transmission_gain = physics::kRadPerSecToRPM / static_cast<double>(clutch.getDrivenInertia());
+    const double lock_slip = Clutch::kLockSlipRPM;
+    double engine_rpm = 3000.0;
+    double trans_rpm = 0.0;
+    bool locked = false;
+    run.events = 0;
+    const int steps_per_segment = static_cast<int>(std::lround(kSegmentSeconds / dt));
+    for (int s = 0; s < kFrictionSegments; s++) {
+        const FrictionSegment& segment = kFrictionScenario[s];
+        const double engine_accel = segment.engine_accel;
+        const double kinetic_torque = static_cast<double>(segment.engagement) * clutch.getKineticCapacity();
+        const double static_torque = clutch.getStaticRatio() * kinetic_torque;
+        for (int i = 0; i < steps_per_segment; i++) {
+            const double trans_accel = -static_cast<double>(Clutch::kCoastDecayRate) * trans_rpm;
+            const bool was_locked = locked;
+            const physics::FrictionStep<double> step = physics::frictionStep(
+                engine_rpm, trans_rpm, locked, engine_accel, trans_accel, engine_gain, transmission_gain,
+                kinetic_torque, static_torque, dt, lock_slip);
+            if (locked != was_locked && run.events < 32) {
+                run.event_times[run.events++] = (s * steps_per_segment + i) * dt + std::max(step.event_time, 0.0);
+            }
+        }
+        run.trans_rpm[s] = trans_rpm;
+    }
+}
+
+} // namespace
+
+void runClutchStudy(std::ostream& out) {
+    double reference[kSegments];
+    simulateReference(kReferenceDt, reference);
+
+    static const double kSteps[] = { 0.001, 0.01, 0.05, 0.1, 0.25 };
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "Clutch solver study: %d s of pedal work, reference Analytic in double @ dt=%g s\n",
+                  static_cast<int>(kSegments * kSegmentSeconds), kReferenceDt);
+    out << line;
+    std::snprintf(line, sizeof(line), "%-10s %8s %14s %14s\n", "solver", "dt (s)", "RMS RPM err", "max RPM err");
+    out << line;
+
+    // The RPM-blending solvers; Friction needs shaft accelerations and has its own table below
+    for (int k = 0; k <= static_cast<int>(ClutchSolver::Analytic); k++) {
+        const ClutchSolver solver = static_cast<ClutchSolver>(k);
+        for (double dt : kSteps) {
+            float trans[kSegments];
+            simulate(solver, dt, trans);
+
+            double sum_sq = 0.0;
+            double max_error = 0.0;
+            for (int s = 0; s < kSegments; s++) {
+                const double error = std::fabs(static_cast<double>(trans[s]) - reference[s]);
+                sum_sq += error * error;
+                max_error = std::max(max_error, error);
+            }
+            std::snprintf(line, sizeof(line), "%-10s %8g %14.3f %14.3f\n", clutchSolverName(solver), dt,
+                          std::sqrt(sum_sq / kSegments), max_error);
+            out << line;
+        }
+    }
+
+    // Friction clutch: dt invariance of the lock-up/breakaway times
+    static FrictionRun friction_reference;
+    simulateFrictionReference(kReferenceDt, friction_reference);
+
+    std::snprintf(line, sizeof(line), "\nFriction clutch: %d s scenario, reference event detection in double @ dt=%g s (%d lock/unlock events)\n",
+                  static_cast<int>(kFrictionSegments * kSegmentSeconds), kReferenceDt, friction_reference.events);
+    out << line;
+    std::snprintf(line, sizeof(line), "%-18s %8s %14s %14s %8s %16s\n", "regime switching", "dt (s)",
+                  "RMS RPM err", "max RPM err", "events", "max event err ms");
+    out << line;
+
+    for (int mode = 0; mode < 2; mode++) {
+        const bool event_detection = mode == 0;
+        for (double dt : kSteps) {
+            static FrictionRun run;
+            simulateFriction(event_detection, dt, run);
+
+            double sum_sq = 0.0;
+            double max_error = 0.0;
+            for (int s = 0; s < kFrictionSegments; s++) {
+                const double error = std::fabs(run.trans_rpm[s] - friction_reference.trans_rpm[s]);
+                sum_sq += error * error;
+                max_error = std::max(max_error, error);
+            }
+            char event_error[32] = "-";
+            if (event_detection && run.events == friction_reference.events) {
+                double worst = 0.0;
+                for (int e = 0; e < run.events; e++) {
+                    worst = std::max(worst, std::fabs(run.event_times[e] - friction_reference.event_times[e]));
+                }
+                std::snprintf(event_error, sizeof(event_error), "%.3f", worst * 1000.0);
+            }
+            std::snprintf(line, sizeof(line), "%-18s %8g %14.3f %14.3f %8d %16s\n",
+                          event_detection ? "event detection" : "step boundaries", dt,
+                          std::sqrt(sum_sq / kFrictionSegments), max_error, run.events, event_error);
+            out << line;
+        }
+    }
+}
+
+} // namespace bench
+} // namespace ev_sim
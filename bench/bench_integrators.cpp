@@ -0,0 +1,131 @@
+#include "bench.hpp"
+#include "engine.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace ev_sim {
+namespace bench {
+
+namespace {
+
+constexpr double kSegmentSeconds = 0.5;   // Inputs change every half second
+constexpr int kSegments = 40;             // 20 s drive
+constexpr double kReferenceDt = 1e-4;     // RK4 at this step is the reference solution
+
+/**
+ * Piecewise-constant inputs of one segment
+ */
+struct SegmentInput {
+    float throttle;          // [0, 1]
+    float clutch_engagement; // [0, 1]
+    float load_torque;       // Nm
+};
+
+// Throttle blips, cruise and lift-offs with the clutch in, out and slipping;
+// throttle stays above the engine-braking threshold so the idle governor is
+// not involved (it is a proportional controller, not part of the engine ODE)
+SegmentInput segmentInput(int segment) {
+    static const float kThrottle[8] = { 0.35f, 0.5f, 0.4f, 0.6f, 0.3f, 0.45f, 0.55f, 0.38f };
+    static const float kEngagement[5] = { 0.0f, 1.0f, 0.5f, 1.0f, 0.25f };
+    SegmentInput input;
+    input.throttle = kThrottle[segment % 8];
+    input.clutch_engagement = kEngagement[segment % 5];
+    input.load_torque = 25.0f + 15.0f * input.clutch_engagement;
+    return input;
+}
+
+/**
+ * Run the drive and sample RPM at the end of every segment
+ */
+void simulate(EngineIntegrator integrator, double dt, float* rpm_samples) {
+    Engine engine(800.0f, 7000.0f, 0.1f, 200.0f, 0.25f);
+    engine.setIntegrator(integrator);
+    engine.setRPM(5500.0f);
+    const int steps_per_segment = static_cast<int>(std::lround(kSegmentSeconds / dt));
+    for (int s = 0; s < kSegments; s++) {
+        const SegmentInput input = segmentInput(s);
+        for (int i = 0; i < steps_per_segment; i++) {
+            engine.update(input.throttle, input.load_torque, input.clutch_engagement, static_cast<float>(dt));
+        }
+        rpm_samples[s] = engine.getRPM();
+    }
+}
+
+} // namespace
+
+void runIntegratorStudy(std::ostream& out, double tolerance_rpm) {
+    float reference[kSegments];
+    simulate(EngineIntegrator::RK4, kReferenceDt, reference);
+
+    static const double kSteps[] = { 0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25 };
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "Engine integrator study: %d s drive, reference RK4 @ dt=%g s, tolerance %.1f RPM\n",
+                  static_cast<int>(kSegments * kSegmentSeconds), kReferenceDt, tolerance_rpm);
+    out << line;
+    std::snprintf(line, sizeof(line), "%-20s %8s %16s %12s %12s  %s\n", "integrator", "dt (s)",
+                  "us per sim-s", "RMS RPM err", "max RPM err", "within tolerance");
+    out << line;
+
+    const char* best_name = nullptr;
+    double best_dt = 0.0;
+    double best_cost = 0.0;
+
+    for (int k = 0; k < static_cast<int>(EngineIntegrator::Count); k++) {
+        const EngineIntegrator integrator = static_cast<EngineIntegrator>(k);
+        for (double dt : kSteps) {
+            float rpm[kSegments];
+
+            // Repeat until the timing is long enough to trust
+            int runs = 0;
+            const Runner::Clock::time_point start = Runner::Clock::now();
+            double elapsed = 0.0;
+            do {
+                simulate(integrator, dt, rpm);
+                doNotOptimize(rpm[kSegments - 1]);
+                runs++;
+                elapsed = std::chrono::duration<double>(Runner::Clock::now() - start).count();
+            } while (elapsed < 0.02);
+            const double us_per_sim_second = elapsed * 1e6 / runs / (kSegments * kSegmentSeconds);
+
+            double sum_sq = 0.0;
+            double max_error = 0.0;
+            bool finite = true;
+            for (int s = 0; s < kSegments; s++) {
+                if (!std::isfinite(rpm[s])) {
+                    finite = false;
+                    break;
+                }
+                const double error = std::fabs(static_cast<double>(rpm[s]) - reference[s]);
+                sum_sq += error * error;
+                max_error = std::max(max_error, error);
+            }
+            const double rms_error = finite ? std::sqrt(sum_sq / kSegments) : INFINITY;
+            if (!finite) {
+                max_error = INFINITY;
+            }
+            const bool within = max_error <= tolerance_rpm;
+
+            std::snprintf(line, sizeof(line), "%-20s %8g %16.2f %12.3f %12.3f  %s\n", engineIntegratorName(integrator),
+                          dt, us_per_sim_second, rms_error, max_error, within ? "yes" : "no");
+            out << line;
+
+            if (within && (!best_name || us_per_sim_second < best_cost)) {
+                best_name = engineIntegratorName(integrator);
+                best_dt = dt;
+                best_cost = us_per_sim_second;
+            }
+        }
+    }
+
+    if (best_name) {
+        std::snprintf(line, sizeof(line), "Cheapest within %.1f RPM: %s at dt=%g s (%.2f us per simulated second)\n",
+                      tolerance_rpm, best_name, best_dt, best_cost);
+    } else {
+        std::snprintf(line, sizeof(line), "No configuration is within %.1f RPM\n", tolerance_rpm);
+    }
+    out << line;
+}
+
+} // namespace bench
+} // namespace ev_sim
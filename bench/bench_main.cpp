@@ -0,0 +1,348 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace ev_sim {
+namespace bench {
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+const char* compilerName() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+} // namespace
+
+Runner::Runner(double min_time, int repetitions, const std::string& filter)
+    : min_time_(min_time)
+    , repetitions_(std::max(repetitions, 1))
+    , filter_(filter)
+{
+}
+
+bool Runner::enabled(const std::string& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+}
+
+bool Runner::enablePerfCounters() {
+    perf_.reset(new PerfCounters());
+    return perf_->isAvailable();
+}
+
+void Runner::record(const std::string& name, const char* unit, uint64_t iterations,
+                    const std::vector<double>& samples_ns, const PerfSample& counters) {
+    const SampleStats stats = summarizeSamples(samples_ns);
+    BenchResult result;
+    result.name = name;
+    result.unit = unit;
+    result.iterations = iterations;
+    result.value = stats.median > 0.0 ? 1e9 / stats.median : 0.0;
+    result.ns_per_op = stats.median;
+    result.ci_low_ns = stats.ci_low;
+    result.ci_high_ns = stats.ci_high;
+    result.samples_ns = samples_ns;
+    result.counters = counters;
+    results_.push_back(result);
+    std::fprintf(stderr, "  %-32s done\n", name.c_str());
+}
+
+void Runner::printTable(std::ostream& out) const {
+    const bool counters = perf_ && perf_->isAvailable();
+    out << std::left << std::setw(34) << "benchmark" << std::right << std::setw(16) << "ops/s"
+        << std::setw(14) << "ns/op" << std::setw(14) << "iterations";
+    if (repetitions_ > 1) {
+        out << std::setw(22) << "95% CI ns/op";
+    }
+    if (counters) {
+        out << std::setw(12) << "cyc/op" << std::setw(8) << "IPC" << std::setw(12) << "brmiss/op"
+            << std::setw(12) << "llcmiss/op";
+    }
+    out << "  unit\n";
+
+    for (const BenchResult& result : results_) {
+        out << std::left << std::setw(34) << result.name << std::right
+            << std::setw(16) << std::fixed << std::setprecision(0) << result.value
+            << std::setw(14) << std::setprecision(1) << result.ns_per_op
+            << std::setw(14) << result.iterations;
+        if (repetitions_ > 1) {
+            char interval[48];
+            std::snprintf(interval, sizeof(interval), "[%.1f, %.1f]", result.ci_low_ns, result.ci_high_ns);
+            out << std::setw(22) << interval;
+        }
+        if (counters) {
+            const PerfSample& sample = result.counters;
+            const double ops = static_cast<double>(result.iterations);
+            auto perOp = [&](PerfEvent event, int width, int precision) {
+                out << std::setw(width);
+                if (sample.has(event)) {
+                    out << std::setprecision(precision) << sample.get(event) / ops;
+                } else {
+                    out << "-";
+                }
+            };
+            perOp(PerfEvent::Cycles, 12, 1);
+            out << std::setw(8);
+            if (sample.has(PerfEvent::Cycles) && sample.has(PerfEvent::Instructions) && sample.get(PerfEvent::Cycles) > 0) {
+                out << std::setprecision(2)
+                    << static_cast<double>(sample.get(PerfEvent::Instructions)) / sample.get(PerfEvent::Cycles);
+            } else {
+                out << "-";
+            }
+            perOp(PerfEvent::BranchMisses, 12, 3);
+            perOp(PerfEvent::CacheMisses, 12, 4);
+        }
+        out << "  " << result.unit << '\n';
+    }
+
+    if (perf_ && !perf_->isAvailable()) {
+        out << "Hardware counters unavailable: " << perf_->unavailableReason() << '\n';
+    }
+}
+
+void Runner::writeJson(std::ostream& out) const {
+    out << "{\n  \"schema\": \"ev_sim_bench/1\",\n";
+    out << "  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+    out << "  \"compiler\": ";
+    writeJsonString(out, compilerName());
+#ifdef NDEBUG
+    out << ",\n  \"optimized\": true,\n";
+#else
+    out << ",\n  \"optimized\": false,\n";
+#endif
+    out << "  \"min_time\": " << min_time_ << ",\n";
+    out << "  \"repetitions\": " << repetitions_ << ",\n";
+    if (perf_) {
+        out << "  \"perf_counters\": {\"available\": " << (perf_->isAvailable() ? "true" : "false");
+        if (!perf_->isAvailable()) {
+            out << ", \"reason\": ";
+            writeJsonString(out, perf_->unavailableReason());
+        }
+        out << "},\n";
+    }
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results_.size(); i++) {
+        const BenchResult& result = results_[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeJsonString(out, result.name);
+        out << ", \"unit\": ";
+        writeJsonString(out, result.unit);
+        out << std::setprecision(6) << std::defaultfloat
+            << ", \"value\": " << result.value
+            << ", \"ns_per_op\": " << result.ns_per_op
+            << ", \"ci_low_ns\": " << result.ci_low_ns
+            << ", \"ci_high_ns\": " << result.ci_high_ns
+            << ", \"iterations\": " << result.iterations
+            << ", \"samples_ns\": [";
+        for (size_t s = 0; s < result.samples_ns.size(); s++) {
+            out << (s == 0 ? "" : ", ") << result.samples_ns[s];
+        }
+        out << "]";
+
+        // Hardware events per operation
+        bool any_counter = false;
+        for (int e = 0; e < static_cast<int>(PerfEvent::Count); e++) {
+            const PerfEvent event = static_cast<PerfEvent>(e);
+            if (!result.counters.has(event)) {
+                continue;
+            }
+            out << (any_counter ? ", " : ", \"counters_per_op\": {") << '"' << perfEventName(event) << "\": "
+                << static_cast<double>(result.counters.get(event)) / result.iterations;
+            any_counter = true;
+        }
+        out << (any_counter ? "}}" : "}");
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace bench
+} // namespace ev_sim
+
+namespace {
+
+void printUsage(const char* argv0) {
+    std::printf("Usage: %s [options]\n"
+                "  --filter <substring>     Only run benchmarks whose name contains the substring\n"
+                "  --min-time <seconds>     Minimum time per measured batch (default 0.5)\n"
+                "  --repetitions <n>        Measured batches per benchmark (default 1, 10 with a baseline)\n"
+                "  --out <file.json>        Write JSON results to a file\n"
+                "  --json                   Print JSON to stdout instead of the table\n"
+                "  --perf                   Count cycles, instructions, branch and cache misses (Linux)\n"
+                "  --baseline-out <file>    Record these results as a baseline\n"
+                "  --compare <file>         Compare with a baseline; exit 1 on regression\n"
+                "  --threshold <percent>    Slowdown of the median that counts as a regression (default 5)\n"
+                "  --integrator-study       Compare engine integrators (accuracy vs. cost) and exit\n"
+                "  --tolerance-rpm <rpm>    Error tolerance for --integrator-study (default 10)\n"
+                "  --clutch-study           Compare clutch solvers across time steps and exit\n"
+                "  --realtime <seconds>     Run the physics tick loop in real time and check it against the SLA\n"
+                "  --tick-hz <hz>           Tick rate for --realtime (default 10)\n"
+                "  --sla-p99-ms <ms>        Maximum p99 tick lateness (default 5, negative = unchecked)\n"
+                "  --sla-max-ms <ms>        Maximum tick lateness (default 20, negative = unchecked)\n"
+                "  --sla-max-dropped <n>    Maximum dropped ticks (default 0, negative = unchecked)\n"
+                "Exit status: 0 ok, 1 regression or SLA violation, 2 usage or I/O error\n", argv0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string out_path;
+    double min_time = 0.5;
+    bool json_stdout = false;
+    bool perf = false;
+    int repetitions = 0;
+    std::string baseline_out_path;
+    std::string compare_path;
+    double threshold_percent = 5.0;
+    bool integrator_study = false;
+    double tolerance_rpm = 10.0;
+    bool clutch_study = false;
+    bool realtime = false;
+    ev_sim::bench::RealtimeOptions realtime_options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--filter") == 0 && has_value) {
+            filter = argv[++i];
+        } else if (std::strcmp(arg, "--min-time") == 0 && has_value) {
+            min_time = std::max(std::atof(argv[++i]), 0.001);
+        } else if (std::strcmp(arg, "--out") == 0 && has_value) {
+            out_path = argv[++i];
+        } else if (std::strcmp(arg, "--json") == 0) {
+            json_stdout = true;
+        } else if (std::strcmp(arg, "--perf") == 0) {
+            perf = true;
+        } else if (std::strcmp(arg, "--repetitions") == 0 && has_value) {
+            repetitions = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(arg, "--baseline-out") == 0 && has_value) {
+            baseline_out_path = argv[++i];
+        } else if (std::strcmp(arg, "--compare") == 0 && has_value) {
+            compare_path = argv[++i];
+        } else if (std::strcmp(arg, "--threshold") == 0 && has_value) {
+            threshold_percent = std::max(std::atof(argv[++i]), 0.0);
+        } else if (std::strcmp(arg, "--integrator-study") == 0) {
+            integrator_study = true;
+        } else if (std::strcmp(arg, "--tolerance-rpm") == 0 && has_value) {
+            tolerance_rpm = std::max(std::atof(argv[++i]), 0.0);
+        } else if (std::strcmp(arg, "--clutch-study") == 0) {
+            clutch_study = true;
+        } else if (std::strcmp(arg, "--realtime") == 0 && has_value) {
+            realtime = true;
+            realtime_options.seconds = std::max(std::atof(argv[++i]), 0.1);
+        } else if (std::strcmp(arg, "--tick-hz") == 0 && has_value) {
+            realtime_options.tick_hz = std::max(std::atof(argv[++i]), 1.0);
+        } else if (std::strcmp(arg, "--sla-p99-ms") == 0 && has_value) {
+            realtime_options.sla.p99_lateness_ms = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--sla-max-ms") == 0 && has_value) {
+            realtime_options.sla.max_lateness_ms = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--sla-max-dropped") == 0 && has_value) {
+            realtime_options.sla.max_dropped = std::atoll(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    if (integrator_study) {
+        ev_sim::bench::runIntegratorStudy(std::cout, tolerance_rpm);
+        return 0;
+    }
+    if (clutch_study) {
+        ev_sim::bench::runClutchStudy(std::cout);
+        return 0;
+    }
+
+    // Real-time mode replaces the throughput benchmarks
+    if (realtime) {
+        return ev_sim::bench::runRealtimeCheck(realtime_options, std::cout, out_path) ? 0 : 1;
+    }
+
+    // Load the baseline first so a bad path fails before minutes of measuring
+    std::vector<ev_sim::bench::BaselineEntry> baseline;
+    if (!compare_path.empty()) {
+        std::string error;
+        if (!ev_sim::bench::loadBaseline(compare_path, baseline, error)) {
+            std::fprintf(stderr, "Cannot load baseline %s: %s\n", compare_path.c_str(), error.c_str());
+            return 2;
+        }
+    }
+
+    // Statistical comparison needs several samples per benchmark
+    if (repetitions == 0) {
+        repetitions = (!compare_path.empty() || !baseline_out_path.empty()) ? 10 : 1;
+    }
+
+    ev_sim::bench::Runner runner(min_time, repetitions, filter);
+    if (perf && !runner.enablePerfCounters()) {
+        std::fprintf(stderr, "Hardware counters unavailable (%s); reporting wall time only\n",
+                     runner.perfCounters()->unavailableReason().c_str());
+    }
+    ev_sim::bench::runPhysicsBenchmarks(runner);
+    ev_sim::bench::runUiBenchmarks(runner);
+
+    if (json_stdout) {
+        runner.writeJson(std::cout);
+    } else {
+        runner.printTable(std::cout);
+    }
+
+    for (const std::string& path : { out_path, baseline_out_path }) {
+        if (path.empty()) {
+            continue;
+        }
+        std::ofstream file(path);
+        if (!file) {
+            std::fprintf(stderr, "Failed to open %s\n", path.c_str());
+            return 2;
+        }
+        runner.writeJson(file);
+    }
+
+    if (!compare_path.empty()) {
+        const std::vector<ev_sim::bench::Comparison> comparisons =
+            ev_sim::bench::compareToBaseline(runner.results(), baseline, threshold_percent);
+        // Keep stdout clean JSON when --json is used
+        std::ostream& report = json_stdout ? std::cerr : std::cout;
+        ev_sim::bench::printComparison(report, comparisons, threshold_percent);
+        for (const ev_sim::bench::Comparison& comparison : comparisons) {
+            if (comparison.regressed) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,463 @@
+#include "bench.hpp"
+#include "drivetrain.hpp"
+#include "driver_model.hpp"
+#include "dual.hpp"
+#include "battery.hpp"
+#include "motor.hpp"
+#include "multi_rate_scheduler.hpp"
+#include "rewind_buffer.hpp"
+#include "vehicle.hpp"
+#include "what_if.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace ev_sim {
+namespace bench {
+
+namespace {
+
+constexpr int kInputSamples = 1024;   // Power of two so the input index is a mask
+constexpr float kDt = 0.1f;           // Same fixed step as the dashboard
+
+/**
+ * Pedal trace replayed by every physics benchmark: throttle sweeps and a
+ * clutch that periodically dips and re-engages, so all branches are hit.
+ * The pedals are stored in percent, as Drivetrain::step takes them;
+ * benchmarks below the drivetrain read them through throttle() and
+ * engagement(), which apply Drivetrain::step's own conversions so every
+ * benchmark runs the engine at the same operating points.
+ */
+struct InputTrace {
+    float throttle_percent[kInputSamples];
+    float clutch_pedal_percent[kInputSamples];
+
+    float throttle(int k) const { return throttle_percent[k] * 0.01f; }                // Engine [0, 1]
+    float engagement(int k) const { return 1.0f - clutch_pedal_percent[k] / 100.0f; }  // 1 = engaged
+
+    InputTrace() {
+        for (int i = 0; i < kInputSamples; i++) {
+            const float phase = static_cast<float>(i) / kInputSamples;
+            throttle_percent[i] = 50.0f + 50.0f * std::sin(phase * 6.2831853f * 3.0f);
+            clutch_pedal_percent[i] = 50.0f + 50.0f * std::cos(phase * 6.2831853f * 5.0f);
+        }
+    }
+};
+
+Engine makeEngine() {
+    return Engine(800.0f, 7000.0f, 0.1f, 200.0f, 0.25f);
+}
+
+constexpr int kFleetSize = 1024;
+
+// Fleet members differ in mass and grade so no two lanes are alike
+VehicleParameters fleetVehicle(int index) {
+    VehicleParameters params;
+    params.mass = 1200.0f + 0.5f * index;
+    params.grade = 0.0001f * (index % 100) - 0.002f;
+    return params;
+}
+
+} // namespace
+
+void runPhysicsBenchmarks(Runner& runner) {
+    static const InputTrace trace;
+
+    runner.run("physics/engine_update", "steps/s", [](uint64_t iterations) {
+        Engine engine = makeEngine();
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            engine.update(trace.throttle(k), 20.0f,
+                          trace.engagement(k), kDt);
+        }
+        doNotOptimize(engine.getRPM());
+    });
+
+    // Same inputs under the non-default integrators
+    const EngineIntegrator variants[] = { EngineIntegrator::ExplicitEuler, EngineIntegrator::RK4 };
+    const char* variant_names[] = { "physics/engine_update_explicit_euler", "physics/engine_update_rk4" };
+    for (int v = 0; v < 2; v++) {
+        const EngineIntegrator integrator = variants[v];
+        runner.run(variant_names[v], "steps/s", [integrator](uint64_t iterations) {
+            Engine engine = makeEngine();
+            engine.setIntegrator(integrator);
+            for (uint64_t i = 0; i < iterations; i++) {
+                const int k = static_cast<int>(i & (kInputSamples - 1));
+                engine.update(trace.throttle(k), 20.0f,
+                              trace.engagement(k), kDt);
+            }
+            doNotOptimize(engine.getRPM());
+        });
+    }
+
+    runner.run("physics/engine_calculate_torque", "calls/s", [](uint64_t iterations) {
+        Engine engine = makeEngine();
+        float sum = 0.0f;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            // Walk the whole curve: idle to redline every kInputSamples calls
+            if (k == 0 || k == kInputSamples / 2) {
+                engine.setRPM(engine.getIdleRPM());
+            }
+            engine.setRPM(engine.getRPM() + 12.0f);
+            sum += engine.calculateTorque(trace.throttle(k));
+        }
+        doNotOptimize(sum);
+    });
+
+    // Same physics core at double precision, then carrying d(torque)/d(rpm)
+    runner.run("physics/engine_torque_double", "calls/s", [](uint64_t iterations) {
+        double rpm = 800.0;
+        double sum = 0.0;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            if (k == 0 || k == kInputSamples / 2) {
+                rpm = 800.0;
+            }
+            rpm += 12.0;
+            sum += physics::engineTorque(rpm, static_cast<double>(trace.throttle(k)), 7000.0, 200.0);
+        }
+        doNotOptimize(sum);
+    });
+
+    runner.run("physics/engine_torque_dual", "calls/s", [](uint64_t iterations) {
+        using D = Dual<float>;
+        float rpm = 800.0f;
+        float sum = 0.0f;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            if (k == 0 || k == kInputSamples / 2) {
+                rpm = 800.0f;
+            }
+            rpm += 12.0f;
+            const D torque = physics::engineTorque(D::variable(rpm), D(trace.throttle(k)),
+                                                   D(7000.0f), D(200.0f));
+            sum += torque.value + torque.derivative;
+        }
+        doNotOptimize(sum);
+    });
+
+    // Analytic solver (default), then the original per-step factors
+    const ClutchSolver solvers[] = { ClutchSolver::Analytic, ClutchSolver::PerStep };
+    const char* solver_names[] = { "physics/clutch_update", "physics/clutch_update_per_step" };
+    for (int v = 0; v < 2; v++) {
+        const ClutchSolver solver = solvers[v];
+        runner.run(solver_names[v], "steps/s", [solver](uint64_t iterations) {
+            Clutch clutch(10.0f);
+            clutch.setSolver(solver);
+            float engine_rpm = 3000.0f;
+            float transmission_rpm = 0.0f;
+            for (uint64_t i = 0; i < iterations; i++) {
+                const int k = static_cast<int>(i & (kInputSamples - 1));
+                if (k == 0) {
+                    engine_rpm = 3000.0f;
+                    transmission_rpm = 0.0f;
+                }
+                engine_rpm += trace.throttle_percent[k] - 50.0f;
+                clutch.update(engine_rpm, transmission_rpm, trace.engagement(k), kDt);
+            }
+            doNotOptimize(engine_rpm);
+            doNotOptimize(transmission_rpm);
+        });
+    }
+
+    runner.run("physics/drivetrain_step", "steps/s", [](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            drivetrain.step(trace.throttle_percent[k], trace.clutch_pedal_percent[k], kDt);
+        }
+        doNotOptimize(drivetrain.getEngineRPM());
+        doNotOptimize(drivetrain.getTransmissionRPM());
+    });
+
+    runner.run("physics/drivetrain_step_friction", "steps/s", [](uint64_t iterations) {
+        Clutch clutch(10.0f);
+        clutch.setSolver(ClutchSolver::Friction);
+        Drivetrain drivetrain(makeEngine(), clutch);
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            drivetrain.step(trace.throttle_percent[k], trace.clutch_pedal_percent[k], kDt);
+        }
+        doNotOptimize(drivetrain.getEngineRPM());
+        doNotOptimize(drivetrain.getTransmissionRPM());
+    });
+
+    // The same steps in third gear, so the road load, reflected inertia and
+    // output shaft path run (the steps above stay in neutral)
+    auto stepGeared = [](Drivetrain& drivetrain, uint64_t iterations) {
+        drivetrain.getGearbox().requestGear(3);
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            drivetrain.step(trace.throttle_percent[k], trace.clutch_pedal_percent[k], kDt);
+        }
+        doNotOptimize(drivetrain.getEngineRPM());
+        doNotOptimize(drivetrain.getOutputRPM());
+    };
+
+    runner.run("physics/drivetrain_step_geared", "steps/s", [stepGeared](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        stepGeared(drivetrain, iterations);
+    });
+
+    runner.run("physics/drivetrain_step_geared_friction", "steps/s", [stepGeared](uint64_t iterations) {
+        Clutch clutch(10.0f);
+        clutch.setSolver(ClutchSolver::Friction);
+        Drivetrain drivetrain(makeEngine(), clutch);
+        stepGeared(drivetrain, iterations);
+    });
+
+    // One op = one vehicle step; the fleet is stepped whole, each vehicle
+    // under its share of the pedal trace as wheel torque
+    runner.run("physics/vehicle_step", "steps/s", [](uint64_t iterations) {
+        std::vector<Vehicle> fleet;
+        for (int v = 0; v < kFleetSize; v++) {
+            fleet.emplace_back(fleetVehicle(v));
+        }
+        for (uint64_t i = 0; i < iterations; i += kFleetSize) {
+            const int k = static_cast<int>((i / kFleetSize) & (kInputSamples - 1));
+            for (int v = 0; v < kFleetSize; v++) {
+                fleet[v].step(trace.throttle_percent[(k + v) & (kInputSamples - 1)] * 20.0f, kDt);
+            }
+        }
+        doNotOptimize(fleet[0].getSpeed());
+    });
+
+    runner.run("physics/vehicle_batch_step", "steps/s", [](uint64_t iterations) {
+        VehicleBatch fleet;
+        for (int v = 0; v < kFleetSize; v++) {
+            fleet.add(fleetVehicle(v));
+        }
+        for (uint64_t i = 0; i < iterations; i += kFleetSize) {
+            const int k = static_cast<int>((i / kFleetSize) & (kInputSamples - 1));
+            float* wheel_torque = fleet.wheelTorque();
+            for (int v = 0; v < kFleetSize; v++) {
+                wheel_torque[v] = trace.throttle_percent[(k + v) & (kInputSamples - 1)] * 20.0f;
+            }
+            fleet.step(kDt);
+        }
+        doNotOptimize(fleet.speed()[0]);
+    });
+
+    // Motor operating points from the pedal trace: speed from the clutch
+    // channel, torque from the throttle, covering the whole map
+    runner.run("physics/efficiency_map_lookup", "lookups/s", [](uint64_t iterations) {
+        const TractionMotor motor;
+        const EfficiencyMap& map = motor.getMap();
+        float sum = 0.0f;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            sum += map.lookup(trace.clutch_pedal_percent[k] * 70.0f, trace.throttle_percent[k] * 2.0f);
+        }
+        doNotOptimize(sum);
+    });
+
+    runner.run("physics/efficiency_map_batch", "lookups/s", [](uint64_t iterations) {
+        const TractionMotor motor;
+        std::vector<float> rpm(kInputSamples);
+        std::vector<float> torque(kInputSamples);
+        std::vector<float> efficiency(kInputSamples);
+        for (int k = 0; k < kInputSamples; k++) {
+            rpm[k] = trace.clutch_pedal_percent[k] * 70.0f;
+            torque[k] = trace.throttle_percent[k] * 2.0f;
+        }
+        for (uint64_t i = 0; i < iterations; i += kInputSamples) {
+            motor.getMap().lookup(rpm.data(), torque.data(), efficiency.data(), kInputSamples);
+            doNotOptimize(efficiency[0]);
+        }
+    });
+
+    // 2D tables, one lookup per op, scalar against batched: the motor's
+    // efficiency map resampled onto a Table2D (uniform axes) and the engine
+    // torque map (non-uniform axes)
+    const MotorParameters motor_params;
+    const EfficiencyMap motor_map = motorEfficiencyMap(motor_params);
+    const Table2D efficiency_map = tabulate(TableAxis(0.0f, motor_params.max_rpm, motor_params.rpm_points),
+                                            TableAxis(0.0f, motor_params.max_torque, motor_params.torque_points),
+                                            [&](float rpm, float torque) { return motor_map.lookup(rpm, torque); });
+    const Table2D torque_map = engineTorqueMap(makeEngine());
+    struct TableCase {
+        const char* scalar_name;
+        const char* batch_name;
+        const Table2D* table;
+        float x_scale;             // Trace % to x
+        float y_scale;             // Trace % to y
+    };
+    const TableCase table_cases[] = {
+        { "physics/table2d_lookup_uniform", "physics/table2d_batch_uniform", &efficiency_map, 70.0f, 2.0f },
+        { "physics/table2d_lookup_nonuniform", "physics/table2d_batch_nonuniform", &torque_map, 70.0f, 0.01f },
+    };
+    for (const TableCase& c : table_cases) {
+        runner.run(c.scalar_name, "lookups/s", [&c](uint64_t iterations) {
+            float sum = 0.0f;
+            for (uint64_t i = 0; i < iterations; i++) {
+                const int k = static_cast<int>(i & (kInputSamples - 1));
+                sum += c.table->lookup(trace.clutch_pedal_percent[k] * c.x_scale, trace.throttle_percent[k] * c.y_scale);
+            }
+            doNotOptimize(sum);
+        });
+        runner.run(c.batch_name, "lookups/s", [&c](uint64_t iterations) {
+            std::vector<float> x(kInputSamples);
+            std::vector<float> y(kInputSamples);
+            std::vector<float> out(kInputSamples);
+            for (int k = 0; k < kInputSamples; k++) {
+                x[k] = trace.clutch_pedal_percent[k] * c.x_scale;
+                y[k] = trace.throttle_percent[k] * c.y_scale;
+            }
+            for (uint64_t i = 0; i < iterations; i += kInputSamples) {
+                c.table->lookup(x.data(), y.data(), out.data(), kInputSamples);
+                doNotOptimize(out[0]);
+            }
+        });
+    }
+
+    // Engine and friction clutch reading their maps instead of the formulas
+    runner.run("physics/engine_update_torque_map", "steps/s", [](uint64_t iterations) {
+        Engine engine = makeEngine();
+        engine.setTorqueMap(std::make_shared<const Table2D>(engineTorqueMap(engine)));
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            engine.update(trace.throttle(k), 20.0f,
+                          trace.engagement(k), kDt);
+        }
+        doNotOptimize(engine.getRPM());
+    });
+
+    runner.run("physics/drivetrain_step_friction_maps", "steps/s", [](uint64_t iterations) {
+        Engine engine = makeEngine();
+        engine.setTorqueMap(std::make_shared<const Table2D>(engineTorqueMap(engine)));
+        Clutch clutch(10.0f);
+        clutch.setSolver(ClutchSolver::Friction);
+        clutch.setCapacityMap(std::make_shared<const Table2D>(clutchCapacityMap(clutch.getKineticCapacity())));
+        Drivetrain drivetrain(engine, clutch);
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            drivetrain.step(trace.throttle_percent[k], trace.clutch_pedal_percent[k], kDt);
+        }
+        doNotOptimize(drivetrain.getEngineRPM());
+        doNotOptimize(drivetrain.getTransmissionRPM());
+    });
+
+    // Map lookup, DC power and the battery's current solve: the per-step
+    // electrical cost added to a drivetrain step
+    runner.run("physics/electric_drive_step", "steps/s", [](uint64_t iterations) {
+        TractionMotor motor;
+        Battery battery;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            battery.step(motor.update(trace.throttle_percent[k] * 2.0f, trace.clutch_pedal_percent[k] * 70.0f), kDt);
+        }
+        doNotOptimize(battery.getSOC());
+    });
+
+    // Driver decision alone against a parked drivetrain: the per-vehicle
+    // cost of a closed-loop driver in a batched run
+    runner.run("physics/driver_model_update", "steps/s", [](uint64_t iterations) {
+        const Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        DriverModel driver;
+        float throttle = 0.0f;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            throttle += driver.update(drivetrain, trace.throttle_percent[k] * 0.3f, kDt).throttle_percent;
+        }
+        doNotOptimize(throttle);
+    });
+
+    // Driver plus friction drivetrain step, to set against drivetrain_step_friction
+    runner.run("physics/drivetrain_step_driven", "steps/s", [](uint64_t iterations) {
+        Clutch clutch(10.0f);
+        clutch.setSolver(ClutchSolver::Friction);
+        Drivetrain drivetrain(makeEngine(), clutch);
+        DriverModel driver;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            driver.step(drivetrain, trace.throttle_percent[k] * 0.3f, kDt);
+        }
+        doNotOptimize(drivetrain.getEngineRPM());
+        doNotOptimize(drivetrain.getVehicle().getSpeed());
+    });
+
+    // Rewind recording: capture the drivetrain state into the ring once per op
+    runner.run("physics/drivetrain_snapshot", "snapshots/s", [](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        RewindBuffer<DrivetrainState> ring(600);
+        for (uint64_t i = 0; i < iterations; i++) {
+            drivetrain.setTransmissionRPM(static_cast<float>(i & 1023));
+            ring.push(drivetrain.snapshot());
+        }
+        doNotOptimize(ring.newest().transmission_rpm);
+    });
+
+    runner.run("physics/drivetrain_restore", "restores/s", [](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        RewindBuffer<DrivetrainState> ring(600);
+        for (int i = 0; i < 600; i++) {
+            drivetrain.setTransmissionRPM(static_cast<float>(i));
+            ring.push(drivetrain.snapshot());
+        }
+        for (uint64_t i = 0; i < iterations; i++) {
+            drivetrain.restore(ring.fromNewest(i % 600));
+            doNotOptimize(drivetrain.getTransmissionRPM());
+        }
+    });
+
+    // What-if: 24 clutch release variants forked from one state, 5 s (50 ticks) each
+    runner.run("physics/what_if_fanout", "fan-outs/s", [](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        std::vector<DriverCommand> inputs(50);
+        for (int i = 0; i < 50; i++) {
+            drivetrain.step(trace.throttle_percent[i], trace.clutch_pedal_percent[i], kDt);
+            inputs[i].throttle_percent = trace.throttle_percent[50 + i];
+            inputs[i].clutch_pedal_percent = trace.clutch_pedal_percent[50 + i];
+            inputs[i].gear = drivetrain.getGearbox().getRequestedGear();
+        }
+        const DrivetrainState fork = drivetrain.snapshot();
+        const std::vector<WhatIfVariant> variants = releaseTimeSweep(24, 0.1f, 2.0f);
+        ThreadPool pool;
+        for (uint64_t i = 0; i < iterations; i++) {
+            const std::vector<WhatIfResult> results = runWhatIf(drivetrain, fork, inputs, variants, kDt, pool);
+            doNotOptimize(results.back().final_speed_kmh);
+        }
+    });
+
+    // 1 ms of simulated time per op: drivetrain at 1 kHz with thermal and
+    // telemetry at the same rate, then at 10 Hz / 100 Hz on the scheduler
+    const double kFastPeriod = 0.001;
+    runner.run("physics/subsystems_single_rate", "ticks/s", [kFastPeriod](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        float telemetry[kInputSamples];
+        for (uint64_t i = 0; i < iterations; i++) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            drivetrain.step(trace.throttle_percent[k], trace.clutch_pedal_percent[k], kFastPeriod);
+            drivetrain.getEngine().updateThermal(kFastPeriod);
+            telemetry[k] = drivetrain.getEngineRPM();
+        }
+        doNotOptimize(telemetry[0]);
+        doNotOptimize(drivetrain.getEngine().getTemperature());
+    });
+
+    runner.run("physics/subsystems_multi_rate", "ticks/s", [kFastPeriod](uint64_t iterations) {
+        Drivetrain drivetrain(makeEngine(), Clutch(10.0f));
+        float telemetry[kInputSamples];
+        uint64_t i = 0;
+        MultiRateScheduler scheduler(kFastPeriod);
+        scheduler.addTask("drivetrain", kFastPeriod, [&](double dt) {
+            const int k = static_cast<int>(i & (kInputSamples - 1));
+            drivetrain.step(trace.throttle_percent[k], trace.clutch_pedal_percent[k], static_cast<float>(dt));
+        });
+        scheduler.addTask("thermal", 0.1, [&](double dt) {
+            drivetrain.getEngine().updateThermal(static_cast<float>(dt));
+        });
+        scheduler.addTask("telemetry", 0.01, [&](double) {
+            telemetry[i & (kInputSamples - 1)] = drivetrain.getEngineRPM();
+        });
+        for (i = 0; i < iterations; i++) {
+            scheduler.tick();
+        }
+        doNotOptimize(telemetry[0]);
+        doNotOptimize(drivetrain.getEngine().getTemperature());
+    });
+}
+
+} // namespace bench
+} // namespace ev_sim
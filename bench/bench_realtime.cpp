@@ -0,0 +1,99 @@
+#include "bench.hpp"
+#include "drivetrain.hpp"
+#include "frame_pacer.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace ev_sim {
+namespace bench {
+
+bool runRealtimeCheck(const RealtimeOptions& options, std::ostream& report, const std::string& json_path) {
+    using Clock = FramePacer::Clock;
+
+    Drivetrain drivetrain(Engine(800.0f, 7000.0f, 0.1f, 200.0f, 0.25f), Clutch(10.0f));
+    const double period = 1.0 / options.tick_hz;
+    TickScheduler scheduler(period);
+    TickMonitor monitor(options.bin_ms);
+    FramePacer pacer(PacingMode::CappedFps, static_cast<float>(options.tick_hz));
+
+    const Clock::time_point start = Clock::now();
+    auto seconds_since_start = [&](Clock::time_point t) {
+        return std::chrono::duration<double>(t - start).count();
+    };
+    scheduler.reset(0.0);
+
+    uint64_t step_index = 0;
+    while (seconds_since_start(Clock::now()) < options.seconds) {
+        const double now = seconds_since_start(Clock::now());
+        const int steps = scheduler.poll(now);
+        monitor.recordDropped(scheduler.lastDropped());
+        for (int i = 0; i < steps; i++, step_index++) {
+            monitor.recordTick(scheduler.scheduledTime(i), now, steps);
+            // Same pedal sweep shape as the physics benchmarks
+            const float phase = static_cast<float>(step_index % 200) / 200.0f;
+            drivetrain.step(50.0f + 50.0f * std::sin(phase * 6.2831853f),
+                            50.0f + 50.0f * std::cos(phase * 6.2831853f), static_cast<float>(period));
+        }
+        pacer.preciseWaitUntil(start + std::chrono::duration_cast<Clock::duration>(
+                                           std::chrono::duration<double>(scheduler.nextDue())));
+    }
+    doNotOptimize(drivetrain.getEngineRPM());
+
+    const TickStats stats = monitor.stats();
+    std::string violation;
+    const bool passed = monitor.meetsSla(options.sla, &violation);
+
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "Real-time check: %.1f s at %.1f Hz\n"
+                  "  ticks %llu, caught up %llu, dropped %llu\n"
+                  "  lateness ms: mean %.3f  jitter %.3f  p50 %.3f  p99 %.3f  max %.3f\n",
+                  options.seconds, options.tick_hz, static_cast<unsigned long long>(stats.ticks),
+                  static_cast<unsigned long long>(stats.caught_up), static_cast<unsigned long long>(stats.dropped),
+                  stats.mean_ms, stats.jitter_ms, stats.p50_ms, stats.p99_ms, stats.max_ms);
+    report << line;
+    std::snprintf(line, sizeof(line), "  SLA (p99 <= %.2f ms, max <= %.2f ms, dropped <= %lld): %s%s\n",
+                  options.sla.p99_lateness_ms, options.sla.max_lateness_ms,
+                  static_cast<long long>(options.sla.max_dropped), passed ? "PASS" : "FAIL: ",
+                  passed ? "" : violation.c_str());
+    report << line;
+
+    // Lateness histogram, one row per non-empty bin
+    for (int i = 0; i < TickMonitor::kHistogramBins; i++) {
+        const uint64_t n = monitor.histogram()[i];
+        if (n == 0) {
+            continue;
+        }
+        const bool overflow = i == TickMonitor::kHistogramBins - 1;
+        std::snprintf(line, sizeof(line), "  %5.1f%s ms %8llu\n", i * monitor.getBinMs(), overflow ? "+" : " ",
+                      static_cast<unsigned long long>(n));
+        report << line;
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream file(json_path);
+        if (!file) {
+            report << "Failed to open " << json_path << '\n';
+            return false;
+        }
+        file << "{\n  \"schema\": \"ev_sim_bench_realtime/1\",\n"
+             << "  \"seconds\": " << options.seconds << ",\n  \"tick_hz\": " << options.tick_hz << ",\n"
+             << "  \"ticks\": " << stats.ticks << ",\n  \"caught_up\": " << stats.caught_up
+             << ",\n  \"dropped\": " << stats.dropped << ",\n"
+             << "  \"lateness_ms\": {\"mean\": " << stats.mean_ms << ", \"jitter\": " << stats.jitter_ms
+             << ", \"p50\": " << stats.p50_ms << ", \"p99\": " << stats.p99_ms << ", \"max\": " << stats.max_ms << "},\n"
+             << "  \"histogram\": {\"bin_ms\": " << monitor.getBinMs() << ", \"counts\": [";
+        for (int i = 0; i < TickMonitor::kHistogramBins; i++) {
+            file << (i == 0 ? "" : ", ") << monitor.histogram()[i];
+        }
+        file << "]},\n  \"sla\": {\"p99_lateness_ms\": " << options.sla.p99_lateness_ms
+             << ", \"max_lateness_ms\": " << options.sla.max_lateness_ms
+             << ", \"max_dropped\": " << options.sla.max_dropped << "},\n"
+             << "  \"passed\": " << (passed ? "true" : "false") << "\n}\n";
+    }
+    return passed;
+}
+
+} // namespace bench
+} // namespace ev_sim
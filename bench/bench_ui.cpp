@@ -0,0 +1,147 @@
+#include "bench.hpp"
+#include "dashboard.hpp"
+#include "gauge_renderer.hpp"
+#include <imgui.h>
+#include <cmath>
+#include <memory>
+
+namespace ev_sim {
+namespace bench {
+
+namespace {
+
+constexpr int kGaugeCount = 8;
+
+/**
+ * Headless ImGui context: fonts are built on the CPU and draw data is
+ * produced by Render() but never submitted, so only draw-list building is
+ * measured.
+ */
+class HeadlessImGui {
+public:
+    HeadlessImGui() {
+        IMGUI_CHECKVERSION();
+        context_ = ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(1280.0f, 720.0f);
+        io.DeltaTime = 1.0f / 60.0f;
+        io.IniFilename = nullptr;
+        io.LogFilename = nullptr;
+        ImGui::StyleColorsDark();
+
+        unsigned char* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    }
+
+    ~HeadlessImGui() {
+        ImGui::DestroyContext(context_);
+    }
+
+    HeadlessImGui(const HeadlessImGui&) = delete;
+    HeadlessImGui& operator=(const HeadlessImGui&) = delete;
+
+    /**
+     * Run one frame; build() is called between NewFrame() and Render()
+     */
+    template <typename Build>
+    void frame(Build&& build) {
+        ImGui::NewFrame();
+        build();
+        ImGui::Render();
+        doNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+    }
+
+private:
+    ImGuiContext* context_;
+};
+
+// Needle value for gauge g on frame i
+float gaugeValue(uint64_t frame, int gauge) {
+    return 3500.0f + 3000.0f * std::sin(static_cast<float>(frame % 628) * 0.01f + gauge);
+}
+
+void beginGaugeWindow() {
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(1280.0f, 400.0f));
+    ImGui::Begin("Gauges", nullptr, ImGuiWindowFlags_NoDecoration);
+}
+
+} // namespace
+
+void runUiBenchmarks(Runner& runner) {
+    if (!runner.enabled("ui/")) {
+        return;
+    }
+
+    HeadlessImGui imgui;
+    const ImVec4 gauge_color(1.0f, 0.3f, 0.3f, 1.0f);
+
+    // Frame overhead shared by all UI benchmarks
+    runner.run("ui/empty_frame", "frames/s", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            imgui.frame([] {
+                beginGaugeWindow();
+                ImGui::End();
+            });
+        }
+    });
+
+    runner.run("ui/gauge_immediate_x8", "frames/s", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            imgui.frame([&] {
+                beginGaugeWindow();
+                for (int g = 0; g < kGaugeCount; g++) {
+                    if (g % 4 != 0) ImGui::SameLine();
+                    ImGui::PushID(g);   // Same "RPM" label on every gauge, distinct InvisibleButton IDs
+                    drawRPMGauge("RPM", gaugeValue(i, g), 7000.0f, gauge_color);
+                    ImGui::PopID();
+                }
+                ImGui::End();
+            });
+        }
+    });
+
+    std::unique_ptr<GaugeRenderer> gauges[kGaugeCount];
+    for (int g = 0; g < kGaugeCount; g++) {
+        gauges[g].reset(new GaugeRenderer("RPM", 7000.0f, gauge_color));
+    }
+    runner.run("ui/gauge_cached_x8", "frames/s", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            imgui.frame([&] {
+                beginGaugeWindow();
+                for (int g = 0; g < kGaugeCount; g++) {
+                    if (g % 4 != 0) ImGui::SameLine();
+                    ImGui::PushID(g);
+                    gauges[g]->draw(gaugeValue(i, g));
+                    ImGui::PopID();
+                }
+                ImGui::End();
+            });
+        }
+    });
+
+    // No GL context: the plot takes the ImDrawList polyline path
+    PlotRenderer plot(100);
+    const HistoryChannels channels = addHistoryChannels(plot);
+    runner.run("ui/history_window", "frames/s", [&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            const float engine_rpm = gaugeValue(i, 0);
+            const float transmission_rpm = gaugeValue(i, 1);
+            const float throttle = 50.0f + 50.0f * std::sin(static_cast<float>(i) * 0.05f);
+            const float clutch = 50.0f + 50.0f * std::cos(static_cast<float>(i) * 0.03f);
+            plot.push(channels.engine_rpm, engine_rpm);
+            plot.push(channels.trans_rpm, transmission_rpm);
+            plot.push(channels.throttle, throttle);
+            plot.push(channels.clutch_pedal, clutch);
+            imgui.frame([&] {
+                drawHistoryWindow(plot, channels,
+                                  { engine_rpm, transmission_rpm, throttle, clutch, static_cast<float>(i) * 0.1f });
+            });
+        }
+    });
+}
+
+} // namespace bench
+} // namespace ev_sim
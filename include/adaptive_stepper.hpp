@@ -0,0 +1,73 @@
+#pragma once
+
+#include "drivetrain.hpp"
+#include <cstdint>
+
+namespace ev_sim {
+
+/**
+ * Error control settings for AdaptiveStepper
+ */
+struct AdaptiveStepOptions {
+    float tolerance_rpm = 1.0f;    // Allowed local error per step (engine and transmission RPM)
+    double min_dt = 1e-4;          // Steps never shrink below this (accepted regardless of error)
+    double max_dt = 0.5;           // Steps never grow beyond this
+    double initial_dt = 0.01;
+};
+
+/**
+ * Step statistics of a replay
+ */
+struct StepCounts {
+    uint64_t accepted = 0;         // Steps that advanced the simulation
+    uint64_t rejected = 0;         // Adaptive steps retried with a smaller dt
+    uint64_t evaluations = 0;      // Drivetrain::step calls, including error estimates
+    double min_dt = 0.0;           // Smallest and largest accepted step (s)
+    double max_dt = 0.0;
+    uint64_t fast_forwards = 0;    // Steady-state jumps (replay with fast-forward)
+    double fast_forward_seconds = 0.0; // Simulated time covered by jumps
+    float fast_forward_bound = 0.0f;   // Largest error bound of a jump (RPM)
+};
+
+/**
+ * Error-controlled variable-step driver for Drivetrain
+ *
+ * Each step is taken once with dt and again as two dt/2 steps; the
+ * difference estimates the local error (step doubling). The two-half-step
+ * result is kept when the error is within tolerance, otherwise dt shrinks
+ * and the step is retried. The next dt follows the usual controller for a
+ * first-order method, dt * 0.9 * sqrt(tolerance / error), limited to a
+ * factor of 5 either way, so quiescent stretches run at max_dt and clutch
+ * engagements refine automatically.
+ *
+ * The drivetrain is treated as a black box, so the estimate covers every
+ * engine integrator and clutch solver, including the friction clutch's
+ * lock-up events.
+ */
+class AdaptiveStepper {
+public:
+    explicit AdaptiveStepper(const AdaptiveStepOptions& options = AdaptiveStepOptions());
+
+    /**
+     * Take one accepted step with inputs held
+     * @param max_step Upper bound for this step, e.g. time to the next input change
+     * @return Length of the step taken (s)
+     */
+    double step(Drivetrain& drivetrain, float throttle_percent, float clutch_pedal_percent, double max_step);
+
+    /**
+     * Forget the step size history (keeps the counts)
+     */
+    void restart() { dt_ = options_.initial_dt; }
+
+    const StepCounts& counts() const { return counts_; }
+    double suggestedStep() const { return dt_; }
+    const AdaptiveStepOptions& getOptions() const { return options_; }
+
+private:
+    AdaptiveStepOptions options_;
+    double dt_;                    // Step size the controller proposes next
+    StepCounts counts_;
+};
+
+} // namespace ev_sim
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace ev_sim {
+
+constexpr size_t kCacheLineBytes = 64;
+
+/**
+ * std::allocator replacement returning storage aligned to `Alignment` bytes
+ *
+ * For tables that are laid out around cache lines: with the base aligned,
+ * a row padded to a multiple of kCacheLineBytes starts on its own line.
+ */
+template <typename T, size_t Alignment = kCacheLineBytes>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* pointer, size_t) {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+} // namespace ev_sim
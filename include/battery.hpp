@@ -0,0 +1,88 @@
+#pragma once
+
+namespace ev_sim {
+
+/**
+ * Traction battery pack as an open-circuit voltage behind a resistance
+ *
+ * The defaults are a ~22 kWh, 320-400 V pack.
+ */
+struct BatteryParameters {
+    float capacity_ah = 60.0f;            // Pack capacity (Ah)
+    float empty_voltage = 320.0f;         // Open-circuit voltage at 0% SOC (V)
+    float full_voltage = 400.0f;          // and at 100%, linear in between (V)
+    float internal_resistance = 0.1f;     // Pack resistance (Ω)
+    float initial_soc = 0.9f;             // State of charge at start [0, 1]
+};
+
+/**
+ * Battery state as plain data
+ */
+struct BatteryState {
+    double soc;
+    double energy;                 // J
+    double loss_energy;            // J
+    float voltage;                 // V
+    float current;                 // A
+};
+
+/**
+ * Battery state of charge under a DC power demand
+ *
+ * Each step draws a power P at the terminals; the current solves
+ *   P = (V_oc - R * I) * I,
+ * taken in the form I = 2P / (V_oc + sqrt(V_oc² - 4RP)), which is exact at
+ * P = 0 and for negative (charging) power. Demand beyond the pack's
+ * matched-load maximum V_oc² / 4R is clipped to it. Charge is counted in
+ * double so millions of small steps do not round away.
+ */
+class Battery {
+public:
+    explicit Battery(const BatteryParameters& params = BatteryParameters());
+
+    /**
+     * Draw power for one step
+     * @param power_w Demand at the terminals (W; negative charges)
+     * @param dt Step duration (seconds)
+     */
+    void step(float power_w, float dt);
+
+    float getSOC() const { return static_cast<float>(soc_); }     // [0, 1]
+    float getOpenCircuitVoltage() const;                          // V
+    float getVoltage() const { return voltage_; }                 // Terminal, last step (V)
+    float getCurrent() const { return current_; }                 // Last step (A; negative charging)
+    float getPower() const { return voltage_ * current_; }        // Delivered, last step (W)
+    float getLossPower() const;                                   // I²R, last step (W)
+    double getEnergy() const { return energy_; }                  // Net delivered since reset (J)
+    double getLossEnergy() const { return loss_energy_; }         // Heat in the resistance since reset (J)
+    const BatteryParameters& getParameters() const { return params_; }
+
+    /**
+     * Set the state of charge and zero the energy counters
+     */
+    void reset(float soc);
+
+    BatteryState snapshot() const { return { soc_, energy_, loss_energy_, voltage_, current_ }; }
+    void restore(const BatteryState& state) {
+        soc_ = state.soc;
+        energy_ = state.energy;
+        loss_energy_ = state.loss_energy;
+        voltage_ = state.voltage;
+        current_ = state.current;
+    }
+
+private:
+    BatteryParameters params_;
+    double soc_;
+    double energy_;
+    double loss_energy_;
+    float voltage_;
+    float current_;
+
+    // Derived from the parameters
+    float resistance_;             // Ω, kept above 0
+    float inv_four_resistance_;    // 1 / 4R, for the power limit
+    double soc_per_coulomb_;       // 1 / capacity (1/C)
+};
+
+} // namespace ev_sim
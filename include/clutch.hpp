@@ -1,7 +1,34 @@
 #pragma once
 
+#include "physics_core.hpp"
+#include "table2d.hpp"
+#include <memory>
+
 namespace ev_sim {
 
+/**
+ * How Clutch::update turns convergence rates into per-step factors
+ */
+enum class ClutchSolver {
+    PerStep = 0,    // Original factors: 0.8 per call when locked, engagement*stiffness*dt when slipping
+    Analytic,       // Exact exponential solution, 1 - exp(-k*dt): independent of dt (default)
+    Friction,       // Friction torque with static/kinetic regimes, stepped by Clutch::updateFriction; update() treats it as Analytic
+    Count
+};
+
+const char* clutchSolverName(ClutchSolver solver);
+
+/**
+ * Clutch state without its parameters, trivially copyable
+ */
+struct ClutchState {
+    float engagement_level;
+    bool locked;
+    float transmitted_torque;      // Nm
+    float slip_energy;             // J
+    float event_time;              // s, -1 if none
+};
+
 /**
  * Models a basic clutch that handles RPM matching between engine and transmission
  * 
@@ -9,16 +36,42 @@ namespace ev_sim {
  * - Disengaged (0.0): Engine and transmission spin freely
  * - Fully engaged (1.0): Engine and transmission lock together
  * - Slipping (between 0.0-1.0): RPMs gradually sync up
+ *
+ * Both shafts converge on their average RPM at rate k, so the RPM
+ * difference decays as exp(-k*t): k = engagement * stiffness while
+ * slipping, kLockedRate when fully engaged. A disengaged transmission
+ * in neutral coasts down at kCoastDecayRate; in gear the road load carried
+ * through the gear slows it instead.
+ *
+ * The Friction solver instead transmits torque: up to engagement *
+ * kinetic capacity while slipping, and whatever keeps the shafts together
+ * (up to the higher static capacity) once locked.
  */
 class Clutch {
 private:
     // Clutch parameters
-    const float stiffness_;           // RPM convergence rate (Hz or 1/s)
+    float stiffness_;                 // RPM convergence rate (Hz or 1/s)
+    ClutchSolver solver_;
+    float kinetic_capacity_;          // Slipping torque at full engagement (Nm)
+    float static_ratio_;              // Static / kinetic capacity (friction coefficient ratio)
+    float driven_inertia_;            // Clutch disc + transmission input side (kg⋅m²)
+    std::shared_ptr<const Table2D> capacity_map_;  // Kinetic capacity over engagement × slip; shared, read-only
     
-    // State tracking (for future torque modeling)
+    // State tracking
     float engagement_level_;          // Current engagement level [0.0, 1.0]
+    bool locked_;                     // Shafts stuck together at the end of the last step
+    float transmitted_torque_;        // Mean torque over the last step, engine → transmission (Nm)
+    float slip_energy_;               // Heat dissipated by slip in the last step (J)
+    float event_time_;                // Lock-up/breakaway time within the last step (s), -1 if none
     
 public:
+    // Locked convergence rate (1/s): matches the original 80% per 100 ms step
+    static constexpr float kLockedRate = physics::kClutchLockedRate;
+    // Disengaged transmission spin-down (1/s), ~3% per second
+    static constexpr float kCoastDecayRate = physics::kCoastDecayRate;
+    // Friction solver: slip below this counts as zero (RPM)
+    static constexpr float kLockSlipRPM = 1e-3f;
+    
     /**
      * Constructor
      * @param stiffness RPM convergence rate - higher values = faster sync (default: 10.0 Hz)
@@ -31,16 +84,103 @@ public:
      * @param transmission_rpm Transmission input shaft RPM (modified by reference)  
      * @param clutch_engaged Clutch engagement level [0.0 = disengaged, 1.0 = engaged]
      * @param dt Time step (seconds)
+     * @param engine_share Engine's weight in the common RPM both shafts converge to;
+     *        0.5 = equal inertias (original model), lower when a gear adds load inertia
+     * @param coast Apply the neutral spin-down when disengaged (false in gear)
      */
     void update(float& engine_rpm, float& transmission_rpm, 
-                float clutch_engaged, float dt);
+                float clutch_engaged, float dt, float engine_share = 0.5f, bool coast = true);
+    
+    /**
+     * Advance both shafts through the friction clutch over one step
+     *
+     * The accelerations are what each shaft would do with the clutch open;
+     * they are held over the step, so slip changes linearly and the time it
+     * crosses zero is found exactly. At that point the shafts lock if the
+     * torque needed to keep them together is within the static capacity,
+     * otherwise they slip on in the other direction. A locked clutch breaks
+     * away as soon as that torque exceeds the static capacity. Only steps
+     * containing a transition pay for a second phase.
+     *
+     * @param engine_rpm Engine RPM at the start of the step (modified by reference)
+     * @param transmission_rpm Transmission RPM at the start of the step (modified by reference)
+     * @param engine_accel Engine acceleration without the clutch, flywheel alone (RPM/s)
+     * @param transmission_accel Transmission acceleration without the clutch (RPM/s)
+     * @param engine_inertia Engine-side inertia (kg⋅m²)
+     * @param clutch_engaged Clutch engagement level [0.0 = disengaged, 1.0 = engaged]
+     * @param dt Time step (seconds)
+     * @param reflected_inertia Load inertia reflected onto the transmission input, on top
+     *        of the driven plate's (kg⋅m², e.g. through an engaged gear)
+     */
+    void updateFriction(float& engine_rpm, float& transmission_rpm,
+                        float engine_accel, float transmission_accel,
+                        float engine_inertia, float clutch_engaged, float dt,
+                        float reflected_inertia = 0.0f);
+    
+    /**
+     * Closed-form coast-down of the disengaged transmission
+     *
+     * Same result as stepping a disengaged clutch for `duration` at step
+     * size dt: exp(-kCoastDecayRate * duration) with the Analytic solver,
+     * (1 - kCoastDecayRate * dt)^(duration / dt) with the per-step ones.
+     */
+    float coastDown(float transmission_rpm, double duration, double dt) const;
     
     // Getters
     float getEngagementLevel() const { return engagement_level_; }
     float getStiffness() const { return stiffness_; }
     
-    // For future torque modeling expansion
-    float calculateClutchTorque() const { return 0.0f; } // Placeholder
+    bool isLocked() const { return locked_; }
+    float getSlipEnergy() const { return slip_energy_; }
+    float getEventTime() const { return event_time_; }
+    float getKineticCapacity() const { return kinetic_capacity_; }
+    float getStaticRatio() const { return static_ratio_; }
+    float getDrivenInertia() const { return driven_inertia_; }
+    
+    void setSolver(ClutchSolver solver) { solver_ = solver; }
+    ClutchSolver getSolver() const { return solver_; }
+    
+    /**
+     * Friction solver parameters
+     * @param kinetic_capacity Slipping torque at full engagement (Nm)
+     * @param static_ratio Static / kinetic capacity, >= 1
+     * @param driven_inertia Clutch disc + transmission input side (kg⋅m²)
+     */
+    void setFrictionParameters(float kinetic_capacity, float static_ratio, float driven_inertia);
+    
+    /**
+     * Tabulated kinetic capacity (Nm) over engagement [0, 1] × |slip| (RPM)
+     * in place of engagement * kinetic capacity; null restores that. It is
+     * read at the start-of-step slip and held over the step, like the
+     * accelerations. The static capacity stays static_ratio times it.
+     */
+    void setCapacityMap(std::shared_ptr<const Table2D> map) { capacity_map_ = std::move(map); }
+    const Table2D* getCapacityMap() const { return capacity_map_.get(); }
+    
+    // Mean torque transmitted in the last step, engine → transmission (Nm); 0 unless the Friction solver ran
+    float calculateClutchTorque() const { return transmitted_torque_; }
+    
+    // State snapshots; solver, friction parameters and capacity map are left alone
+    ClutchState snapshot() const {
+        return { engagement_level_, locked_, transmitted_torque_, slip_energy_, event_time_ };
+    }
+    void restore(const ClutchState& state) {
+        engagement_level_ = state.engagement_level;
+        locked_ = state.locked;
+        transmitted_torque_ = state.transmitted_torque;
+        slip_energy_ = state.slip_energy;
+        event_time_ = state.event_time;
+    }
 };
 
-} // namespace ev_sim
\ No newline at end of file
+/**
+ * Capacity map with a progressive bite and fading friction
+ *
+ * Capacity grows as engagement^1.5 (the pedal's first travel barely
+ * grips) and the friction coefficient falls to 85% of its low-slip value
+ * as slip speed grows. Breakpoints are denser where the shape bends.
+ * @param kinetic_capacity Capacity at full engagement and low slip (Nm)
+ */
+Table2D clutchCapacityMap(float kinetic_capacity);
+
+} // namespace ev_sim
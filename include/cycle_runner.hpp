@@ -0,0 +1,116 @@
+#pragma once
+
+#include "drive_cycle.hpp"
+#include "driver_model.hpp"
+#include "drivetrain.hpp"
+#include "thread_pool.hpp"
+#include "battery.hpp"
+#include "motor.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * One vehicle/parameter configuration to evaluate on drive cycles
+ */
+struct CycleConfig {
+    CycleConfig();    // Dashboard engine, friction clutch, default gearbox and vehicle
+
+    std::string name;
+    Engine engine;
+    Clutch clutch;                 // Slip energy needs ClutchSolver::Friction
+    GearboxParameters gearbox;
+    VehicleParameters vehicle;
+    MotorParameters motor;         // Electrical side of the engine's tractive shaft power (no regeneration)
+    BatteryParameters battery;
+    DriverParameters driver;       // Tuning and shift schedule of the closed-loop driver
+};
+
+/**
+ * Cycle run settings
+ */
+struct CycleOptions {
+    double dt = 0.01;              // Fixed physics step (s)
+};
+
+/**
+ * What a configuration achieved on a cycle
+ */
+struct CycleResult {
+    std::string cycle;
+    std::string config;
+    double duration = 0.0;         // s
+    double distance = 0.0;         // Driven (m)
+    double target_distance = 0.0;  // Cycle distance (m)
+    double engine_energy = 0.0;    // Positive shaft work (J)
+    double battery_energy = 0.0;   // Net drawn from the battery, motor/inverter and I²R losses included (J)
+    double final_soc = 0.0;        // Battery state of charge at the end
+    double brake_energy = 0.0;     // Dissipated by the service brakes (J)
+    double slip_energy = 0.0;      // Dissipated by clutch slip (J)
+    double rms_speed_error = 0.0;  // Against the cycle's target speed (km/h)
+    double max_speed_error = 0.0;  // km/h
+    int shifts = 0;
+    uint64_t steps = 0;
+};
+
+/**
+ * Drive one configuration through a cycle
+ *
+ * A DriverModel with the configuration's parameters follows the target
+ * speed, stepping the drivetrain at the fixed dt. Only the cycle is
+ * shared (read-only); everything else is local, so runs are independent.
+ */
+CycleResult runCycle(const DriveCycle& cycle, const CycleConfig& config, const CycleOptions& options);
+
+/**
+ * Standing-start acceleration of one configuration
+ */
+struct AccelerationResult {
+    double time = 0.0;             // To the target speed, or the time limit (s)
+    bool reached = false;
+    double battery_energy = 0.0;   // J
+    int shifts = 0;
+};
+
+/**
+ * Floor the throttle from rest and time the run to a target speed
+ *
+ * The driver launches and shifts by the configuration's schedule
+ * with a target far beyond reach, so it keeps the throttle wide open.
+ */
+AccelerationResult runAcceleration(const CycleConfig& config, const CycleOptions& options,
+                                   float target_kmh = 100.0f, double time_limit = 60.0);
+
+/**
+ * Geared coast-down against the road load alone
+ */
+struct CoastDownResult {
+    int gear = 0;
+    double start_speed = 0.0;      // Once the gear is in (km/h)
+    double deceleration = 0.0;     // Mean over the run, clutch pressed in gear (m/s²)
+    double road_deceleration = 0.0; // Vehicle alone from the same speed (m/s²)
+};
+
+/**
+ * Roll in gear with the clutch pressed and no brakes, and compare with the
+ * vehicle coasting on its own
+ *
+ * The gear is synchronized from start_kmh first. Only the road load should
+ * slow the car; the driveline inertia carried through the gear makes the
+ * geared run decelerate slightly less, never more.
+ */
+CoastDownResult runCoastDown(const CycleConfig& config, const CycleOptions& options, int gear,
+                             float start_kmh = 50.0f, double duration = 10.0);
+
+/**
+ * Every configuration on every cycle, spread over the pool
+ *
+ * Cycles are loaded once by the caller and shared by all workers.
+ * @return cycles.size() × configs.size() results, cycle-major
+ */
+std::vector<CycleResult> runCycles(const std::vector<DriveCycle>& cycles, const std::vector<CycleConfig>& configs,
+                                   const CycleOptions& options, ThreadPool& pool);
+
+} // namespace ev_sim
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "battery.hpp"
+#include "drivetrain.hpp"
+#include "plot_renderer.hpp"
+#include "rewind_buffer.hpp"
+#include "tick_monitor.hpp"
+#include "trace.hpp"
+#include "what_if.hpp"
+#include <cstdint>
+#include <string>
+
+namespace ev_sim {
+
+/**
+ * Plot channels backing the history window
+ */
+struct HistoryChannels {
+    static constexpr int kMaxWhatIf = 24;      // What-if continuations that can be overlaid
+
+    int engine_rpm;
+    int trans_rpm;
+    int throttle;
+    int clutch_pedal;
+    int what_if_engine_rpm[kMaxWhatIf];        // Drawn under the recorded RPM when a what-if is shown
+    int what_if_trans_rpm[kMaxWhatIf];
+};
+
+/**
+ * Current values printed under the history plots
+ */
+struct DashboardReadout {
+    float engine_rpm;
+    float transmission_rpm;
+    float throttle_percent;
+    float clutch_pedal_percent;
+    float simulation_time;
+};
+
+/**
+ * Register the history channels on a plot (call after ImGui is initialized)
+ */
+HistoryChannels addHistoryChannels(PlotRenderer& plot);
+
+/**
+ * Build the "Engine & Transmission RPM Over Time" window
+ * @param plot Plot holding the history channels
+ * @param channels Channels returned by addHistoryChannels()
+ * @param readout Current values for the text readout
+ * @param what_if_shown What-if channels to overlay (0 = none)
+ */
+void drawHistoryWindow(PlotRenderer& plot, const HistoryChannels& channels, const DashboardReadout& readout,
+                       int what_if_shown = 0);
+
+/**
+ * One physics tick of the session, as the rewind ring keeps it
+ */
+struct SessionSnapshot {
+    DrivetrainState drivetrain;
+    BatteryState battery;
+    float simulation_time;
+    uint64_t scheduler_ticks;      // Physics scheduler phase, so slower tasks stay on their ticks
+    float throttle_percent;        // Inputs held over the tick, for the history plots
+    float clutch_pedal_percent;
+};
+
+/**
+ * Rewind window state
+ */
+struct RewindControls {
+    bool paused = false;           // Physics stopped while scrubbing
+    int ticks_back = 0;            // Selected snapshot, counted back from the newest
+};
+
+enum class RewindAction {
+    None = 0,
+    Seek,                          // Selection changed: restore it
+    Resume,                        // Drive on from the selection, dropping the ticks after it
+};
+
+/**
+ * Build the "Rewind" window: pause, scrub back through the ring and drive
+ * on from the selected tick
+ * @param period Tick period (seconds), for the time labels
+ */
+RewindAction drawRewindWindow(RewindControls& controls, const RewindBuffer<SessionSnapshot>& ring, float period);
+
+/**
+ * What-if window state and the last fan-out's results
+ */
+struct WhatIfControls {
+    int variants = 12;             // Clutch release times tried
+    float shortest_release = 0.1f; // s
+    float longest_release = 2.0f;  // s
+    float throttle_scale = 1.0f;   // Applied to every variant's recorded throttle
+    float horizon = 5.0f;          // Simulated after the fork (s)
+    std::vector<WhatIfResult> results;
+    float fork_time = 0.0f;        // Session time of the fork the results start from
+    double run_ms = 0.0;           // Wall time of the last fan-out
+};
+
+enum class WhatIfAction {
+    None = 0,
+    Run,                           // Fork from the rewind selection and fan out
+    Clear,                         // Drop the results and their overlays
+};
+
+/**
+ * Build the "What-if" window: clutch release sweep settings, a run button
+ * (available while the rewind ring is paused) and the results table
+ * @param period Tick period (seconds), for the horizon label
+ */
+WhatIfAction drawWhatIfWindow(WhatIfControls& controls, const RewindControls& rewind, float period);
+
+/**
+ * Build the "Physics Timing" window: tick lateness histogram, lateness over
+ * recent ticks and catch-up/drop counts
+ * @param period Tick period (seconds), for the reference line
+ */
+void drawTickWindow(const TickMonitor& monitor, float period);
+
+#if EV_SIM_TRACE
+/**
+ * State of the trace capture window
+ */
+struct TraceControls {
+    float window_seconds = 5.0f;          // Exported time window, ending now
+    std::string path = "ev_sim_trace.json";
+    std::string status;                   // Result of the last export
+};
+
+/**
+ * Build the "Trace" window: start/stop recording and export the last
+ * window_seconds as Chrome trace-event JSON
+ */
+void drawTraceWindow(TraceControls& controls);
+#endif
+
+} // namespace ev_sim
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * One point of a speed-vs-time drive cycle
+ */
+struct CyclePoint {
+    double time;                   // Seconds from the start of the cycle
+    float speed;                   // Target road speed (m/s)
+};
+
+/**
+ * Standard or custom drive cycle: target speed against time
+ *
+ * Speeds are interpolated linearly between points and held at the last
+ * point's value. A loaded cycle is never modified, so one instance can be
+ * shared by any number of runs on any number of threads; lookups that walk
+ * forward in time carry their own cursor instead of caching it here.
+ *
+ * CSV format: one "time,speed_kmh" row per point, times increasing,
+ * optional header row; '#' starts a comment line. Published cycles (WLTC,
+ * FTP-75, NEDC, ...) are distributed as 1 Hz tables in this shape.
+ */
+class DriveCycle {
+public:
+    DriveCycle();
+
+    /**
+     * Append a point; its time must be after the previous point's
+     * @return false (and nothing appended) if the time does not increase
+     */
+    bool add(double time, float speed_kmh);
+
+    /**
+     * Replace the cycle with the contents of a CSV file
+     * @param error Set to a description of the first problem on failure
+     */
+    bool load(const std::string& path, std::string& error);
+
+    /**
+     * Target speed at time t (m/s)
+     */
+    float speedAt(double t) const;
+
+    /**
+     * Target speed at time t, for callers walking forward in time
+     * @param cursor Index of the segment found last time (start at 0), updated
+     */
+    float speedAt(double t, size_t& cursor) const;
+
+    void setName(const std::string& name) { name_ = name; }
+    const std::string& name() const { return name_; }
+
+    double duration() const { return points_.empty() ? 0.0 : points_.back().time; }
+    double distance() const;       // Distance driven following the cycle exactly (m)
+    size_t size() const { return points_.size(); }
+    bool empty() const { return points_.empty(); }
+    const CyclePoint& point(size_t index) const { return points_[index]; }
+
+private:
+    std::string name_;
+    std::vector<CyclePoint> points_;
+};
+
+/**
+ * The ECE-15 urban cycle (the urban part of NEDC), repeated: 195 s of
+ * stop-and-go up to 50 km/h per repetition
+ */
+DriveCycle urbanCycle(int repetitions = 4);
+
+} // namespace ev_sim
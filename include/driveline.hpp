@@ -0,0 +1,138 @@
+#pragma once
+
+namespace ev_sim {
+
+/**
+ * Gearbox configuration
+ */
+struct GearboxParameters {
+    static constexpr int kMaxGears = 8;
+
+    int gear_count = 5;
+    float ratios[kMaxGears] = { 3.50f, 2.10f, 1.40f, 1.00f, 0.80f };  // Input/output speed, forward gears
+    float output_inertia = 8.4f;          // Everything behind the output shaft, seen at the output (kg⋅m²)
+    float sync_torque = 20.0f;            // Synchronizer cone torque on the input shaft (Nm)
+    float sync_tolerance_rpm = 30.0f;     // Speed mismatch at which the dog ring engages
+    float shift_clutch_limit = 0.1f;      // Clutch engagement above which the gearbox is under load
+};
+
+/**
+ * Gear shift progress
+ */
+enum class ShiftState {
+    Neutral = 0,        // No gear engaged; input and output shafts turn freely
+    Synchronizing,      // Gear selected, synchronizer matching the input shaft to it
+    InGear,             // Dog ring engaged: input = output * ratio
+    Count
+};
+
+const char* shiftStateName(ShiftState state);
+
+/**
+ * Gearbox shift state without the parameters and tables, trivially copyable
+ */
+struct GearboxState {
+    ShiftState state;
+    int gear;
+    int requested_gear;
+    bool grinding;
+    bool blocked;
+    float shift_time;              // s
+};
+
+/**
+ * Per-gear constants, precomputed so that selecting a gear is an index
+ *
+ * Structure of arrays, index 0 = neutral (all zero), 1..gear_count the
+ * forward gears. Neutral's zeros make the in-gear formulas degrade to "no
+ * coupling" without a branch. Gear state lives in the scalar
+ * Drivetrain::step only; there is no batched drivetrain step yet.
+ */
+struct GearTable {
+    static constexpr int kSize = GearboxParameters::kMaxGears + 1;
+
+    float ratio[kSize];              // Input RPM / output RPM
+    float inv_ratio[kSize];          // Output RPM / input RPM
+    float reflected_inertia[kSize];  // Output inertia seen at the input shaft, J_out / ratio² (kg⋅m²)
+};
+
+/**
+ * Manual gearbox with synchronizers and dog engagement
+ *
+ * A shift is a small state machine run before the clutch each step:
+ *  - Leaving a gear needs the gearbox unloaded (clutch engagement at or
+ *    below shift_clutch_limit); until then the request waits, blocked.
+ *  - In neutral with a gear requested, the synchronizer cone applies
+ *    sync_torque to the input shaft (and the reaction to the output) to
+ *    bring the input to output * ratio. With the clutch engaged the cone
+ *    would have to drag the engine too: the shift grinds and makes no
+ *    progress.
+ *  - Within sync_tolerance_rpm the dog ring engages and the remaining
+ *    mismatch is absorbed with momentum conserved.
+ */
+class Gearbox {
+public:
+    explicit Gearbox(const GearboxParameters& params = GearboxParameters());
+
+    /**
+     * Select a gear (0 = neutral); out-of-range gears are clamped
+     */
+    void requestGear(int gear);
+
+    /**
+     * Advance the shift state machine by one step
+     * @param input_rpm Input shaft RPM (moved by the synchronizer)
+     * @param output_rpm Output shaft RPM (reaction of the synchronizer, dog engagement)
+     * @param clutch_engagement Clutch engagement [0, 1] this step
+     * @param input_inertia Input shaft + clutch driven plate (kg⋅m²)
+     * @param dt Time step (seconds)
+     */
+    void updateShift(float& input_rpm, float& output_rpm, float clutch_engagement, float input_inertia, float dt) {
+        grinding_ = false;
+        blocked_ = false;
+        if (state_ == ShiftState::Synchronizing || requested_gear_ != gear_) {
+            advanceShift(input_rpm, output_rpm, clutch_engagement, input_inertia, dt);
+        }
+    }
+
+    int getGear() const { return gear_; }                 // Engaged gear, 0 unless InGear
+    int getRequestedGear() const { return requested_gear_; }
+    ShiftState getState() const { return state_; }
+    bool isGrinding() const { return grinding_; }         // Last step: synchronizer loaded by the clutch
+    bool isShiftBlocked() const { return blocked_; }      // Last step: could not leave the gear under load
+    float getShiftTime() const { return shift_time_; }    // Time since the pending request (s)
+    int getGearCount() const { return params_.gear_count; }
+    const GearboxParameters& getParameters() const { return params_; }
+    const GearTable& getTable() const { return table_; }
+
+    // Engaged gear's entries (neutral: zeros)
+    float getRatio() const { return table_.ratio[gear_]; }
+    float getInverseRatio() const { return table_.inv_ratio[gear_]; }
+    float getReflectedInertia() const { return table_.reflected_inertia[gear_]; }
+
+    GearboxState snapshot() const { return { state_, gear_, requested_gear_, grinding_, blocked_, shift_time_ }; }
+    void restore(const GearboxState& state) {
+        state_ = state.state;
+        gear_ = state.gear;
+        requested_gear_ = state.requested_gear;
+        grinding_ = state.grinding;
+        blocked_ = state.blocked;
+        shift_time_ = state.shift_time;
+    }
+
+private:
+    // A shift in progress (the common no-shift case stays inline)
+    void advanceShift(float& input_rpm, float& output_rpm, float clutch_engagement, float input_inertia, float dt);
+
+    GearboxParameters params_;
+    GearTable table_;
+
+    ShiftState state_;
+    int gear_;
+    int requested_gear_;
+    bool grinding_;
+    bool blocked_;
+    float shift_time_;
+};
+
+} // namespace ev_sim
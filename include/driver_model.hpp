@@ -0,0 +1,116 @@
+#pragma once
+
+#include "drivetrain.hpp"
+#include <algorithm>
+
+namespace ev_sim {
+
+/**
+ * When the driver shifts and how quickly it lets the clutch in
+ */
+struct ShiftSchedule {
+    ShiftSchedule() { setUpshiftRPM(3000.0f); }
+
+    void setUpshiftRPM(float rpm) { std::fill(upshift_rpm, upshift_rpm + GearboxParameters::kMaxGears, rpm); }
+
+    float upshift_rpm[GearboxParameters::kMaxGears];   // Leave gear g (index g - 1) above this engine RPM
+    float downshift_rpm = 1200.0f;                     // and drop a gear below this one
+    float launch_time = 1.5f;                          // Clutch release from standstill (s)
+    float release_time = 0.4f;                         // Clutch release after a shift (s)
+};
+
+/**
+ * Driver tuning
+ */
+struct DriverParameters {
+    ShiftSchedule schedule;
+    float throttle_gain = 200.0f;          // Pedal % per m/s of speed deficit (full pedal at 0.5 m/s)
+    float throttle_integral_gain = 10.0f;  // Pedal % per m of accumulated deficit
+    float integral_band = 1.0f;            // Integrate only within this speed error (m/s)
+    float brake_gain = 1500.0f;            // Wheel Nm per m/s of excess speed
+    float brake_deadband = 0.3f;           // Excess speed tolerated before braking (m/s)
+    float max_brake_torque = 4000.0f;      // Wheel Nm
+    float hold_brake_torque = 800.0f;      // Held at standstill (wheel Nm)
+    float stop_speed = 0.5f;               // Below this with a zero target the vehicle is stopped (m/s)
+    float creep_speed = 2.0f;              // Clutch in below this when slowing down (m/s)
+    float shift_settle_time = 0.5f;        // No new shift decision within this after one (s)
+};
+
+/**
+ * Inputs for one step
+ */
+struct DriverCommand {
+    float throttle_percent = 0.0f;
+    float clutch_pedal_percent = 100.0f;   // 0 = released/engaged, 100 = pressed/disengaged
+    int gear = 1;                          // Requested gear
+    float brake_torque = 0.0f;             // Service brakes (wheel Nm)
+};
+
+enum class DriverPhase {
+    Stopped = 0,    // Clutch in, brakes held
+    Launch,         // Timed clutch release from standstill
+    Shifting,       // Clutch in until the new gear engages, then a timed release
+    Driving,        // Clutch out, PI speed tracking
+    Count
+};
+
+const char* driverPhaseName(DriverPhase phase);
+
+/**
+ * Closed-loop driver following a target speed
+ *
+ * PI speed control on the throttle, proportional braking beyond a
+ * deadband, a timed clutch release from standstill, and clutch-in shifts at
+ * the schedule's engine speeds with a timed release once the gear is in.
+ * The integral only trims small errors while driving and holds while the
+ * pedal is pinned at 0 or 100 %, so launches, shifts and full-throttle
+ * climbs do not wind it up.
+ *
+ * The state is a few floats and the update reads only vehicle speed,
+ * engine RPM and the gearbox state, with no allocation or table lookups,
+ * so it costs a small fraction of a drivetrain step and one driver per
+ * vehicle in a batched run stays cheap (physics/driver_model_update).
+ */
+class DriverModel {
+public:
+    explicit DriverModel(const DriverParameters& params = DriverParameters());
+
+    /**
+     * Decide the inputs for the next step
+     * @param target Target speed at the end of the step (m/s)
+     */
+    DriverCommand update(const Drivetrain& drivetrain, float target, float dt);
+
+    /**
+     * update(), apply the gear and brake requests, and step the drivetrain
+     */
+    DriverCommand step(Drivetrain& drivetrain, float target, float dt) {
+        const DriverCommand command = update(drivetrain, target, dt);
+        drivetrain.getGearbox().requestGear(command.gear);
+        drivetrain.getVehicle().setBrakeTorque(command.brake_torque);
+        drivetrain.step(command.throttle_percent, command.clutch_pedal_percent, dt);
+        return command;
+    }
+
+    /**
+     * Back to stopped in first gear, counters cleared
+     */
+    void reset();
+
+    DriverPhase getPhase() const { return phase_; }
+    int getShifts() const { return shifts_; }
+    const DriverParameters& getParameters() const { return params_; }
+
+private:
+    void enter(DriverPhase phase);
+
+    DriverParameters params_;
+    DriverPhase phase_;
+    float phase_time_;             // Time in the current phase (s)
+    float since_shift_;            // Time since the last shift started (s)
+    float integral_;               // Accumulated speed deficit (m)
+    int gear_;                     // Gear the driver wants
+    int shifts_;
+};
+
+} // namespace ev_sim
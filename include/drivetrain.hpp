@@ -0,0 +1,119 @@
+#pragma once
+
+#include "engine.hpp"
+#include "clutch.hpp"
+#include "driveline.hpp"
+#include "vehicle.hpp"
+#include <type_traits>
+
+namespace ev_sim {
+
+/**
+ * Complete drivetrain state as plain data
+ *
+ * Everything step() changes and nothing it only reads: parameters, gear
+ * tables and shared maps stay with the Drivetrain. Under 100 bytes, so
+ * capturing or restoring one is a few stores, with no allocation or
+ * reference counting, unlike copying the Drivetrain itself.
+ */
+struct DrivetrainState {
+    EngineState engine;
+    ClutchState clutch;
+    GearboxState gearbox;
+    VehicleState vehicle;
+    float transmission_rpm;
+    float output_rpm;
+    float clutch_engagement;
+    float load_torque;             // Nm
+    float road_torque;             // Nm
+};
+
+static_assert(std::is_trivially_copyable<DrivetrainState>::value, "DrivetrainState must stay plain data");
+
+/**
+ * Engine + clutch + gearbox + vehicle, stepped together
+ *
+ * This is the fixed-step physics update driven by the dashboard, pulled out
+ * of main() so headless runners and benchmarks step exactly the same model.
+ * With ClutchSolver::Friction the clutch transmits torque between the
+ * engine and the transmission instead of blending their RPMs.
+ *
+ * With a gear engaged the output side's reflected inertia loads the
+ * transmission input: the friction clutch sees it as driven inertia, the
+ * blending solvers as a lower engine share of the common RPM. Both come
+ * from per-gear tables, so the step only indexes them by the current gear.
+ * In neutral the model is the original engine/clutch/input shaft one.
+ *
+ * The vehicle's road load (aero, rolling resistance, grade) acts on the
+ * transmission input through the engaged gear and final drive, and the
+ * clutch passes it on to the engine. In gear the vehicle speed follows
+ * the output shaft; in neutral the vehicle coasts on its own and turns
+ * the output shaft.
+ */
+class Drivetrain {
+private:
+    Engine engine_;
+    Clutch clutch_;
+    Gearbox gearbox_;
+    Vehicle vehicle_;
+
+    // Engine weight in the clutch's common RPM per gear: the original equal
+    // weighting of engine and input shaft, plus the reflected output inertia
+    float engine_share_[GearTable::kSize];
+
+    // State
+    float transmission_rpm_;       // Transmission input shaft RPM
+    float output_rpm_;             // Gearbox output shaft RPM
+    float clutch_engagement_;      // Engagement used in the last step [0.0, 1.0]
+    float load_torque_;            // Load applied to the engine in the last step (Nm)
+    float road_torque_;            // Road load at the transmission input in the last step (Nm, 0 in neutral)
+
+public:
+    /**
+     * Constructor
+     * @param engine Engine model (copied)
+     * @param clutch Clutch model (copied)
+     * @param gearbox Gearbox model, rebuilt in neutral with the vehicle as its output inertia
+     * @param vehicle Vehicle model (copied)
+     */
+    Drivetrain(const Engine& engine, const Clutch& clutch, const Gearbox& gearbox = Gearbox(),
+               const Vehicle& vehicle = Vehicle());
+
+    /**
+     * Advance the drivetrain by one time step
+     * @param throttle_percent Throttle pedal [0, 100], scaled to the engine's [0, 1]
+     * @param clutch_pedal_percent Clutch pedal [0 = released/engaged, 100 = pressed/disengaged]
+     * @param dt Time step (seconds)
+     */
+    void step(float throttle_percent, float clutch_pedal_percent, float dt);
+
+    // Getters
+    float getEngineRPM() const { return engine_.getRPM(); }
+    float getTransmissionRPM() const { return transmission_rpm_; }
+    float getOutputRPM() const { return output_rpm_; }
+    float getClutchEngagement() const { return clutch_engagement_; }
+    float getLoadTorque() const { return load_torque_; }
+    float getRoadLoadTorque() const { return road_torque_; }
+
+    Engine& getEngine() { return engine_; }
+    const Engine& getEngine() const { return engine_; }
+    Clutch& getClutch() { return clutch_; }
+    const Clutch& getClutch() const { return clutch_; }
+    Gearbox& getGearbox() { return gearbox_; }
+    const Gearbox& getGearbox() const { return gearbox_; }
+    Vehicle& getVehicle() { return vehicle_; }
+    const Vehicle& getVehicle() const { return vehicle_; }
+
+    /**
+     * Capture the state, or put a captured one back; restoring into a
+     * drivetrain built with different parameters keeps those parameters
+     */
+    DrivetrainState snapshot() const;
+    void restore(const DrivetrainState& state);
+
+    // Setters
+    void setTransmissionRPM(float rpm) { transmission_rpm_ = rpm; }
+    void setOutputRPM(float rpm) { output_rpm_ = rpm; vehicle_.setOutputRPM(rpm); }
+};
+
+} // namespace ev_sim
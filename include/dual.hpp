@@ -0,0 +1,61 @@
+#pragma once
+
+#include "physics_core.hpp"
+#include <cmath>
+
+namespace ev_sim {
+
+/**
+ * Forward-mode dual number: a value and its derivative along one direction
+ *
+ * Running the physics core on Dual<float> gives the sensitivity of any
+ * output to the seeded input, e.g. seed rpm = Dual<float>::variable(rpm) to
+ * get d(torque)/d(rpm) from physics::engineTorque. Comparisons look at the
+ * value only, so piecewise formulas differentiate the active piece.
+ */
+template <typename T>
+struct Dual {
+    T value;
+    T derivative;
+
+    Dual() : value(0), derivative(0) {}
+    Dual(T v) : value(v), derivative(0) {}   // Constant (implicit, so literals convert)
+    Dual(T v, T d) : value(v), derivative(d) {}
+
+    // Independent variable: d/dx x = 1
+    static Dual variable(T v) { return Dual(v, T(1)); }
+
+    Dual& operator+=(const Dual& b) { value += b.value; derivative += b.derivative; return *this; }
+    Dual& operator-=(const Dual& b) { value -= b.value; derivative -= b.derivative; return *this; }
+    Dual& operator*=(const Dual& b) { *this = *this * b; return *this; }
+    Dual& operator/=(const Dual& b) { *this = *this / b; return *this; }
+
+    friend Dual operator+(const Dual& a, const Dual& b) { return Dual(a.value + b.value, a.derivative + b.derivative); }
+    friend Dual operator-(const Dual& a, const Dual& b) { return Dual(a.value - b.value, a.derivative - b.derivative); }
+    friend Dual operator-(const Dual& a) { return Dual(-a.value, -a.derivative); }
+    friend Dual operator*(const Dual& a, const Dual& b) {
+        return Dual(a.value * b.value, a.derivative * b.value + a.value * b.derivative);
+    }
+    friend Dual operator/(const Dual& a, const Dual& b) {
+        return Dual(a.value / b.value, (a.derivative * b.value - a.value * b.derivative) / (b.value * b.value));
+    }
+
+    friend bool operator<(const Dual& a, const Dual& b) { return a.value < b.value; }
+    friend bool operator>(const Dual& a, const Dual& b) { return a.value > b.value; }
+    friend bool operator<=(const Dual& a, const Dual& b) { return a.value <= b.value; }
+    friend bool operator>=(const Dual& a, const Dual& b) { return a.value >= b.value; }
+    friend bool operator==(const Dual& a, const Dual& b) { return a.value == b.value; }
+    friend bool operator!=(const Dual& a, const Dual& b) { return a.value != b.value; }
+
+    // Scalar operations for the physics core (found by argument-dependent lookup)
+    friend Dual select(bool condition, const Dual& if_true, const Dual& if_false) { return condition ? if_true : if_false; }
+    friend Dual min(const Dual& a, const Dual& b) { return b.value < a.value ? b : a; }
+    friend Dual max(const Dual& a, const Dual& b) { return a.value < b.value ? b : a; }
+    friend Dual clamp(const Dual& v, const Dual& low, const Dual& high) { return v < low ? low : (high < v ? high : v); }
+    friend Dual exp(const Dual& a) {
+        const T e = std::exp(a.value);
+        return Dual(e, e * a.derivative);
+    }
+};
+
+} // namespace ev_sim
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "aligned_allocator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Motor/inverter efficiency over speed × torque, on a uniform grid
+ *
+ * Rows are speed points from 0 to max RPM, columns torque points from 0 to
+ * max torque; the map is read with |RPM| and |torque|, so motoring and
+ * generating in either direction share it. Storage is row-major with each
+ * row padded to whole cache lines and the base cache-line aligned: with up
+ * to 16 torque points a row is one line and a lookup touches two lines.
+ *
+ * lookup() is branch-free: the grid coordinates are clamped with min, the
+ * cell index is a truncation, and the last row/column reuse the cell
+ * below them with full weight. Outside the table the edge values hold.
+ *
+ * The motor reads one point per step, so it keeps this compact layout
+ * (about a quarter of a blocked Table2D's memory) rather than Table2D's
+ * gather-friendly one.
+ */
+class EfficiencyMap {
+public:
+    /**
+     * Uniform 100% map (2×2)
+     */
+    EfficiencyMap();
+
+    /**
+     * @param max_rpm Speed of the last row
+     * @param max_torque Torque of the last column (Nm)
+     * @param rpm_points Rows (>= 2)
+     * @param torque_points Columns (>= 2)
+     * @param values rpm_points × torque_points efficiencies (0, 1], row-major
+     */
+    EfficiencyMap(float max_rpm, float max_torque, int rpm_points, int torque_points, const std::vector<float>& values);
+
+    /**
+     * Bilinear efficiency at a speed and torque (either sign)
+     */
+    float lookup(float rpm, float torque) const {
+        const float x = std::min(std::fabs(rpm) * rpm_scale_, last_row_);
+        const float y = std::min(std::fabs(torque) * torque_scale_, last_column_);
+        const int row = std::min(static_cast<int>(x), rpm_points_ - 2);
+        const int column = std::min(static_cast<int>(y), torque_points_ - 2);
+        const float wx = x - static_cast<float>(row);
+        const float wy = y - static_cast<float>(column);
+
+        const float* cell = values_.data() + row * stride_ + column;
+        const float low = cell[0] + (cell[1] - cell[0]) * wy;
+        const float high = cell[stride_] + (cell[stride_ + 1] - cell[stride_]) * wy;
+        return low + (high - low) * wx;
+    }
+
+    /**
+     * lookup() over arrays of operating points
+     */
+    void lookup(const float* rpm, const float* torque, float* efficiency, int count) const;
+
+    float at(int row, int column) const { return values_[row * stride_ + column]; }
+    int getRPMPoints() const { return rpm_points_; }
+    int getTorquePoints() const { return torque_points_; }
+    int getStride() const { return stride_; }                // Floats per padded row
+    float getMaxRPM() const { return last_row_ / rpm_scale_; }
+    float getMaxTorque() const { return last_column_ / torque_scale_; }
+
+private:
+    std::vector<float, AlignedAllocator<float>> values_;
+    int rpm_points_;
+    int torque_points_;
+    int stride_;
+    float rpm_scale_;              // Rows per RPM
+    float torque_scale_;           // Columns per Nm
+    float last_row_;               // rpm_points - 1, as the clamp bound
+    float last_column_;            // torque_points - 1
+};
+
+} // namespace ev_sim
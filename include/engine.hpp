@@ -1,27 +1,68 @@
 #pragma once
 
+#include "table2d.hpp"
+#include "thermal_model.hpp"
+#include <memory>
+
 namespace ev_sim {
 
+/**
+ * Time integration scheme used by Engine::update
+ *
+ * The engine state is (output torque, RPM): the torque follows the torque
+ * curve through a first-order lag and the RPM integrates net torque over
+ * inertia. Throttle, load and clutch engagement are held over the step.
+ */
+enum class EngineIntegrator {
+    ExplicitEuler = 0,     // Both states advanced from the start-of-step rates
+    SemiImplicitEuler,     // Torque lag first, RPM from the new torque (original update, default)
+    RK4,                   // Classic 4th-order Runge-Kutta
+    Count
+};
+
+const char* engineIntegratorName(EngineIntegrator integrator);
+
+/**
+ * Engine state without its parameters: a few floats, trivially copyable
+ */
+struct EngineState {
+    float rpm;
+    float torque_output;           // Nm
+    float torque_derate;           // [0, 1]
+    ThermalState thermal;
+};
+
 class Engine {
 private:
     // Engine State
     float rpm_;                    // Current engine RPM
     float torque_output_;         // Current output torque (Nm)
-    float temperature_;           // Engine temperature (°C)
+    ThermalModel thermal_;        // Engine temperature (updated at the thermal rate)
+    float torque_derate_;         // Thermal torque limit [0, 1], from the last updateThermal()
     
     // Engine Parameters
-    const float idle_rpm_;        // Idle RPM
-    const float max_rpm_;         // Maximum RPM (redline)
-    const float flywheel_inertia_; // kg⋅m²
-    const float max_torque_;      // Maximum torque output (Nm)
-    const float drag_coefficient_; // Nm/(1000 RPM)²
+    float idle_rpm_;              // Idle RPM
+    float max_rpm_;               // Maximum RPM (redline)
+    float flywheel_inertia_;       // kg⋅m²
+    float max_torque_;            // Maximum torque output (Nm)
+    float drag_coefficient_;       // Nm/(1000 RPM)²
+    
+    EngineIntegrator integrator_;
+    std::shared_ptr<const Table2D> torque_map_;  // Torque over RPM × throttle replacing the curve; shared, read-only
+    
+    // Time derivatives of the integrated state
+    struct StateRate {
+        float torque;              // Nm/s
+        float rpm;                 // RPM/s
+    };
     
     // Internal calculations
-    float calculateTorque(float throttle_percent) const;
+    float torqueAt(float rpm, float throttle_percent) const;
+    StateRate stateRate(float torque, float rpm, float throttle_percent, float load_torque, float clutch_engagement) const;
     float calculateRPMChange(float load_torque, float clutch_engagement, float dt) const;
     float calculateDragTorque() const;  // New method for drag calculation
     float calculateEffectiveInertia(float clutch_engagement) const;  // Variable inertia based on clutch state
-    void limitRPM();
+    void limitRPM(float dt);
 
 public:
     Engine(float idle_rpm, float max_rpm, float flywheel_inertia, float max_torque, float drag_coefficient = 0.1f);
@@ -29,19 +70,65 @@ public:
     // Core methods
     void update(float throttle_percent, float load_torque, float clutch_engagement, float dt);
     
+    /**
+     * Advance the thermal model over the heat accumulated by update() and
+     * refresh the torque derating used by the following updates
+     * @param dt Time since the last thermal update (seconds)
+     */
+    void updateThermal(float dt);
+    
+    // Torque curve at the current RPM (throttle clamped to [0, 1])
+    float calculateTorque(float throttle_percent) const;
+    
     // Getters
     float getRPM() const { return rpm_; }
     float getTorque() const { return torque_output_; }
-    float getTemperature() const { return temperature_; }
+    float getTemperature() const { return thermal_.getTemperature(); }
+    float getTorqueDerate() const { return torque_derate_; }
+    const ThermalModel& getThermal() const { return thermal_; }
     
     // Setters (for clutch synchronization)
     void setRPM(float rpm) { rpm_ = rpm; }
+    void setThermalParameters(const ThermalParameters& params) { thermal_ = ThermalModel(params); torque_derate_ = 1.0f; }
+    
+    // State snapshots; parameters, integrator and torque map are left alone
+    EngineState snapshot() const { return { rpm_, torque_output_, torque_derate_, thermal_.snapshot() }; }
+    void restore(const EngineState& state) {
+        rpm_ = state.rpm;
+        torque_output_ = state.torque_output;
+        torque_derate_ = state.torque_derate;
+        thermal_.restore(state.thermal);
+    }
+    
+    /**
+     * Tabulated torque (Nm) over RPM × throttle [0, 1] in place of the
+     * built-in curve; null restores the curve. Thermal derating scales the
+     * map's drive torque and leaves engine braking alone, as with the curve.
+     */
+    void setTorqueMap(std::shared_ptr<const Table2D> map) { torque_map_ = std::move(map); }
+    const Table2D* getTorqueMap() const { return torque_map_.get(); }
+    
+    // Integration scheme
+    void setIntegrator(EngineIntegrator integrator) { integrator_ = integrator; }
+    EngineIntegrator getIntegrator() const { return integrator_; }
     
     // Engine characteristics
     float getIdleRPM() const { return idle_rpm_; }
     float getMaxRPM() const { return max_rpm_; }
+    float getMaxTorque() const { return max_torque_; }
     float getInertia() const { return flywheel_inertia_; }
     float getDragCoefficient() const { return drag_coefficient_; }
 };
 
+/**
+ * The engine's built-in torque curve as a table (full temperature)
+ *
+ * Breakpoints sit on the curve's corners (60% and 85% of max RPM, the rev
+ * limiter from 98%, the engine-braking cut-off at 10% throttle). The
+ * curve is linear in throttle and piecewise linear in RPM above 60%, so
+ * bilinear interpolation reproduces it there exactly; the quadratic rise
+ * below 60% gets eight cells.
+ */
+Table2D engineTorqueMap(const Engine& engine);
+
 } // namespace ev_sim 
\ No newline at end of file
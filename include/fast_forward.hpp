@@ -0,0 +1,89 @@
+#pragma once
+
+#include "drivetrain.hpp"
+
+namespace ev_sim {
+
+/**
+ * Steady-state fast-forward settings for replays
+ */
+struct FastForwardOptions {
+    bool enabled = false;
+    float tolerance_rpm = 0.1f;    // Bound on the RPM error a jump may introduce
+    float max_contraction = 0.999f; // Residuals must shrink at least this fast per step
+    float ratio_settled = 0.002f;  // Residual ratio must change less than this between steps
+    float torque_settled_nm = 0.01f; // Engine torque lag must change less than this per step
+};
+
+/**
+ * Detects quasi-steady drivetrain regimes while inputs are held
+ *
+ * Fed the state after every step, it tracks the per-step RPM change
+ * (residual) of the coupled shafts. Near a fixed point of the step map the
+ * residuals decay geometrically, r(n+1) = rho * r(n) with rho < 1, so the
+ * distance still to travel is at most r * rho / (1 - rho) for all later
+ * steps. The ratio is only trusted once it has stopped changing: while
+ * several modes decay at once (torque lag, idle governor) the early ratios
+ * describe the fastest one and would understate the tail. Steps of
+ * different sizes (adaptive mode) are compared through their RPM rates, with
+ * the ratio rescaled to the latest step size. Once the bound
+ * is within tolerance the state may be held for the rest of the input
+ * segment. This covers the idle governor holding the
+ * engine, a locked clutch at a settled speed and the rev limiter. The
+ * engine's torque lag must have settled as well, so an RPM pinned by the
+ * rev limiter is not mistaken for a steady state while torque still moves.
+ *
+ * In neutral with the clutch fully disengaged the transmission is not
+ * steady but decoupled: it coasts down in closed form (Clutch::coastDown),
+ * so only the engine has to settle. A neutral vehicle rolls on by itself
+ * and is stepped through the jump. In gear the transmission carries the
+ * vehicle and must settle too, clutch or not. A synchronizing gearbox is
+ * never steady. Everything is reset on an input change.
+ *
+ * The bound is an estimate (it assumes the decay stays geometric) and holds
+ * for the state at the end of each jump; later transients can amplify it
+ * like any other perturbation (about 3.5x on the ev_sim_batch demo drive
+ * with the analytic clutch, far more through friction-clutch engagements).
+ * ev_sim_batch --compare measures the amplification instead of assuming it.
+ */
+class SteadyStateDetector {
+public:
+    explicit SteadyStateDetector(const FastForwardOptions& options = FastForwardOptions());
+
+    /**
+     * Forget the history (call when the inputs change)
+     */
+    void reset();
+
+    /**
+     * Record the state after a step
+     * @return true when the drivetrain may be fast-forwarded
+     */
+    bool observe(const Drivetrain& drivetrain, double dt);
+
+    /**
+     * Error bound of the last positive observe() (RPM)
+     */
+    float errorBound() const { return bound_; }
+
+    /**
+     * Jump ahead with inputs held: engine (and a coupled or geared
+     * transmission) stay put, a disengaged transmission in neutral coasts
+     * down in closed form and a neutral vehicle rolls on
+     * @param dt Step size the skipped steps would have used
+     */
+    static void fastForward(Drivetrain& drivetrain, double duration, double dt);
+
+private:
+    FastForwardOptions options_;
+    int observed_;                 // States seen since the last reset
+    float engine_rpm_;             // Previous state
+    float engine_torque_;
+    float transmission_rpm_;
+    double dt_;                    // Step size of the previous step
+    float residual_;               // Previous per-step change
+    float ratio_;                  // Previous contraction per step of size dt_ (< 0: none yet)
+    float bound_;
+};
+
+} // namespace ev_sim
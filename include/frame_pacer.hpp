@@ -0,0 +1,138 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace ev_sim {
+
+/**
+ * Frame pacing strategy for the render loop
+ *
+ * - VSync: the swap blocks on the display refresh (swap interval 1)
+ * - CappedFps: swap interval 0, frames are paced to a target rate with a
+ *   sleep-then-spin wait
+ * - OnDemand: like CappedFps, but frames are only built when the simulation
+ *   state or input changed; the loop blocks on events in between
+ */
+enum class PacingMode {
+    VSync = 0,
+    CappedFps,
+    OnDemand,
+    Count
+};
+
+const char* pacingModeName(PacingMode mode);
+
+/**
+ * Rolling statistics for one pacing mode (refreshed every stats window)
+ */
+struct FrameStats {
+    float fps = 0.0f;              // Rendered frames per second
+    float frame_ms_avg = 0.0f;     // Mean time between rendered frames (ms)
+    float frame_ms_max = 0.0f;     // Worst time between rendered frames (ms)
+    float work_ms_avg = 0.0f;      // Mean time spent building and submitting a frame (ms)
+    float cpu_percent = 0.0f;      // Process CPU time / wall time (100 = one full core)
+    uint64_t frames = 0;           // Total frames rendered in this mode
+};
+
+/**
+ * Paces the render loop and measures the cost of each pacing mode
+ *
+ * Usage per loop iteration:
+ *   pacer.beginFrame();
+ *   if (pacer.shouldRender(state_changed)) { build, render, swap; pacer.endFrame(); }
+ *   pacer.waitForNextFrame();
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor
+     * @param mode Initial pacing mode (default: VSync)
+     * @param target_fps Frame rate cap for CappedFps/OnDemand (default: 60)
+     */
+    FramePacer(PacingMode mode = PacingMode::VSync, float target_fps = 60.0f);
+
+    void setMode(PacingMode mode);
+    void setTargetFps(float target_fps);
+
+    /**
+     * Mark the start of a loop iteration
+     */
+    void beginFrame();
+
+    /**
+     * Decide whether this iteration should build and present a frame
+     * @param state_changed True when input arrived or the simulation stepped
+     * @return Always true outside OnDemand mode
+     */
+    bool shouldRender(bool state_changed);
+
+    /**
+     * Mark the end of a rendered frame (after the swap)
+     */
+    void endFrame();
+
+    /**
+     * Block until the next frame is due (no-op in VSync mode)
+     */
+    void waitForNextFrame();
+
+    /**
+     * Keep rendering for a few frames after a change so ImGui can settle
+     * @param frames Number of extra frames to render
+     */
+    void requestFrames(int frames);
+
+    /**
+     * Sleep until the deadline, then spin for the remainder
+     *
+     * Sleeps in short slices while the remaining time exceeds the observed
+     * sleep overshoot, then busy-waits, so the wake-up error is independent
+     * of the OS timer granularity.
+     */
+    void preciseWaitUntil(Clock::time_point deadline);
+
+    PacingMode getMode() const { return mode_; }
+    bool hasPendingFrames() const { return pending_frames_ > 0; }
+    float getTargetFps() const { return target_fps_; }
+    const FrameStats& getStats(PacingMode mode) const { return stats_[static_cast<int>(mode)]; }
+
+private:
+    void updateStats(Clock::time_point now);
+    void resetWindow(Clock::time_point now);
+
+    PacingMode mode_;
+    float target_fps_;
+    Clock::duration frame_period_;
+
+    Clock::time_point frame_begin_;
+    Clock::time_point last_present_;
+    Clock::time_point next_deadline_;
+    bool has_presented_;
+    int pending_frames_;
+
+    // Running estimate of how long a 1 ms sleep actually takes (seconds)
+    double sleep_estimate_;
+    double sleep_mean_;
+    double sleep_var_;
+    int64_t sleep_samples_;
+
+    // Current stats window
+    Clock::time_point window_start_;
+    double window_cpu_start_;
+    int window_frames_;
+    double window_frame_sum_;
+    double window_frame_max_;
+    double window_work_sum_;
+
+    FrameStats stats_[static_cast<int>(PacingMode::Count)];
+};
+
+/**
+ * CPU time consumed by this process so far (seconds)
+ */
+double processCpuSeconds();
+
+} // namespace ev_sim
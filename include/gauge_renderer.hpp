@@ -0,0 +1,87 @@
+#pragma once
+
+#include <imgui.h>
+#include <string>
+
+namespace ev_sim {
+
+/**
+ * Immediate-mode half-circle RPM gauge
+ *
+ * Recomputes every arc segment, tick mark and label on each call.
+ * Kept as the reference implementation for GaugeRenderer.
+ */
+void drawRPMGauge(const char* label, float value, float max_value, const ImVec4& color, float size = 120.0f);
+
+/**
+ * Half-circle RPM gauge with a cached static dial
+ *
+ * The unit-circle geometry, the background arc, the hub, the tick marks and
+ * the labels are tessellated once per size/font and replayed into the window
+ * draw list as pre-built vertices. Only the value arc, the needle and the
+ * value text are generated per frame.
+ */
+class GaugeRenderer {
+public:
+    static constexpr int kSegments = 32;   // Arc segments over the half circle
+    static constexpr int kTicks = 10;      // Tick intervals over the half circle
+
+    /**
+     * Constructor
+     * @param label Gauge label, also used as the ImGui item ID
+     * @param max_value Full-scale value
+     * @param color Color of the value arc
+     * @param size Gauge width in pixels (default: 120)
+     */
+    GaugeRenderer(const char* label, float max_value, const ImVec4& color, float size = 120.0f);
+
+    /**
+     * Draw the gauge at the current cursor position of the current window
+     * @param value Value to display
+     */
+    void draw(float value);
+
+    // Changing the size or full-scale value invalidates the cached dial
+    void setSize(float size);
+    void setMaxValue(float max_value);
+
+    float getSize() const { return size_; }
+    float getMaxValue() const { return max_value_; }
+
+private:
+    // Pre-tessellated geometry relative to the gauge center
+    struct Mesh {
+        ImVector<ImDrawVert> vtx;
+        ImVector<ImDrawIdx> idx;
+    };
+
+    void rebuildDial();
+    bool dialIsStale() const;
+    static void blitMesh(ImDrawList* draw_list, const Mesh& mesh, const ImVec2& offset);
+
+    std::string label_;
+    float max_value_;
+    ImU32 color_;
+    float size_;
+
+    // Arc sample offsets from the center (unit circle scaled by the radius)
+    ImVec2 arc_points_[kSegments + 1];
+
+    // Static dial layers: drawn below and above the value arc/needle
+    Mesh dial_under_;
+    Mesh dial_over_;
+    ImVec2 value_text_offset_;
+
+    // Cache keys for the dial meshes
+    bool dial_valid_;
+    ImFont* dial_font_;
+    float dial_font_size_;
+    ImTextureID dial_texture_;
+    ImDrawListFlags dial_flags_;
+
+    // Value text is only reformatted when its rounded value changes
+    long last_value_;
+    char value_text_[32];
+};
+
+} // namespace ev_sim
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Driver inputs from a given time onwards (held until the next sample)
+ */
+struct InputSample {
+    double time;                   // Seconds from the start of the drive
+    float throttle_percent;        // Throttle pedal, as read from the controller
+    float clutch_pedal_percent;    // 0 = released/engaged, 100 = pressed/disengaged
+    int gear;                      // Selected gear, 0 = neutral
+};
+
+/**
+ * Recorded or scripted driver inputs for headless replays
+ *
+ * Inputs are piecewise constant: each sample holds until the next one, and
+ * the last sample holds until duration(). Steppers use the sample times as
+ * breakpoints so no step straddles an input change.
+ *
+ * CSV format: one "time,throttle,clutch[,gear]" row per sample, times
+ * increasing, optional header row; '#' starts a comment line. The gear
+ * column defaults to 0 (neutral).
+ */
+class InputTrace {
+public:
+    InputTrace();
+
+    /**
+     * Append a sample; its time must not be before the previous sample's
+     * @return false (and nothing appended) if the time goes backwards
+     */
+    bool add(double time, float throttle_percent, float clutch_pedal_percent, int gear = 0);
+
+    /**
+     * Set the end of the drive (defaults to the last sample time)
+     */
+    void setDuration(double duration) { duration_ = duration; }
+
+    /**
+     * Replace the trace with the contents of a CSV file
+     * @param error Set to a description of the first problem on failure
+     */
+    bool load(const std::string& path, std::string& error);
+
+    /**
+     * Inputs in effect at time t (the first sample before the drive starts);
+     * the trace must not be empty
+     */
+    const InputSample& sampleAt(double t) const;
+
+    size_t size() const { return samples_.size(); }
+    bool empty() const { return samples_.empty(); }
+    const InputSample& sample(size_t index) const { return samples_[index]; }
+    double duration() const;
+
+private:
+    std::vector<InputSample> samples_;
+    double duration_;              // < 0: end at the last sample
+};
+
+} // namespace ev_sim
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "efficiency_map.hpp"
+#include "physics_core.hpp"
+
+namespace ev_sim {
+
+/**
+ * Traction motor and inverter: limits and the loss model the default
+ * efficiency map is generated from
+ *
+ * Losses are copper (∝ torque²), iron (∝ speed), windage (∝ speed²) and a
+ * fixed inverter loss; the defaults peak near 97% at high speed and
+ * moderate torque and match the dashboard engine's 200 Nm / 7000 RPM.
+ */
+struct MotorParameters {
+    float max_torque = 200.0f;            // Nm
+    float max_rpm = 7000.0f;
+    float copper_loss = 0.1f;             // W/Nm²
+    float iron_loss = 0.6f;               // W per rad/s
+    float windage_loss = 0.0006f;         // W/(rad/s)²
+    float inverter_loss = 100.0f;         // W
+    float min_efficiency = 0.5f;          // Floor where the loss model tends to 0 (zero torque or speed)
+    int rpm_points = 32;                  // Map rows
+    int torque_points = 16;               // Map columns: 16 fill one cache line per row
+};
+
+/**
+ * Tabulate the parameters' loss model into an efficiency map over
+ * speed (RPM, rows) × torque (Nm, columns), both from 0 on uniform axes
+ */
+EfficiencyMap motorEfficiencyMap(const MotorParameters& params);
+
+/**
+ * Electrical side of the motor: shaft torque and speed to DC power
+ *
+ * Motoring draws mechanical power / η from the battery, generating returns
+ * mechanical power × η; η comes from the efficiency map, read with |RPM|
+ * and |torque| so all four quadrants share it, and the per-step cost is
+ * one bilinear lookup. The map can be the parametric default or a
+ * measured one.
+ */
+class TractionMotor {
+public:
+    explicit TractionMotor(const MotorParameters& params = MotorParameters());
+    explicit TractionMotor(const EfficiencyMap& map);
+
+    /**
+     * DC power for a shaft operating point (W; negative = regenerating)
+     */
+    float electricalPower(float torque, float rpm) const {
+        return dcPower(torque * rpm / physics::kRadPerSecToRPM, efficiencyAt(torque, rpm));
+    }
+
+    /**
+     * Evaluate and keep the operating point of the last step
+     * @return DC power (W)
+     */
+    float update(float torque, float rpm) {
+        efficiency_ = efficiencyAt(torque, rpm);
+        electrical_power_ = dcPower(torque * rpm / physics::kRadPerSecToRPM, efficiency_);
+        return electrical_power_;
+    }
+
+    float getElectricalPower() const { return electrical_power_; }  // Last update (W)
+    float getEfficiency() const { return efficiency_; }             // Last update
+    const EfficiencyMap& getMap() const { return map_; }
+
+private:
+    float efficiencyAt(float torque, float rpm) const { return map_.lookup(rpm, torque); }
+
+    static float dcPower(float mechanical, float efficiency) {
+        return mechanical > 0.0f ? mechanical / efficiency : mechanical * efficiency;
+    }
+
+    EfficiencyMap map_;
+    float electrical_power_;
+    float efficiency_;
+};
+
+} // namespace ev_sim
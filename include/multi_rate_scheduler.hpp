@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Subsystem registered with a MultiRateScheduler
+ */
+struct ScheduledTask {
+    std::string name;
+    double period;                 // Effective period: a whole number of base ticks (s)
+    int divider;                   // Runs every divider-th base tick
+    uint64_t runs;                 // Times run since the last reset()
+    std::function<void(double)> run; // Called with its own period as dt
+};
+
+/**
+ * Runs subsystems at their own rates on one base tick
+ *
+ * Every period is rounded to a whole number of base ticks, so all rates
+ * share one integer timeline and nothing drifts: a task with divider n
+ * runs at the end of every n-th base tick, receiving n * base period as
+ * its dt. Tasks due on the same tick run in registration order, so
+ * registering the fast physics first and consumers such as thermal and
+ * telemetry after it gives every consumer the state at the end of that
+ * tick, and anything they feed back (e.g. torque derating) takes effect
+ * from the next tick on.
+ */
+class MultiRateScheduler {
+public:
+    /**
+     * Constructor
+     * @param base_period Base tick (seconds), normally the fastest subsystem's period
+     */
+    explicit MultiRateScheduler(double base_period);
+
+    /**
+     * Register a subsystem
+     * @param period Desired period (seconds), rounded to a multiple of the base tick
+     * @param task Called with the effective period
+     * @return Task index
+     */
+    int addTask(const std::string& name, double period, std::function<void(double)> task);
+
+    /**
+     * Restart the timeline at tick 0 and clear run counts
+     */
+    void reset();
+
+    /**
+     * Put the timeline back at a recorded tick count (e.g. ticks() saved
+     * with a state snapshot), so the slower tasks keep their phase; run
+     * counts are left alone
+     */
+    void setTicks(uint64_t ticks);
+
+    /**
+     * Run one base tick
+     */
+    void tick();
+
+    /**
+     * Run every base tick that ends within the next duration; the remainder
+     * carries over to the next call
+     * @return Number of base ticks run
+     */
+    int advance(double duration);
+
+    double getBasePeriod() const { return base_period_; }
+    uint64_t ticks() const { return ticks_; }
+    double time() const { return static_cast<double>(ticks_) * base_period_; }
+
+    int taskCount() const { return static_cast<int>(tasks_.size()); }
+    const ScheduledTask& task(int index) const { return tasks_[index]; }
+
+private:
+    double base_period_;
+    uint64_t ticks_;
+    double pending_;               // Time advanced but not yet ticked (s)
+    std::vector<ScheduledTask> tasks_;
+};
+
+} // namespace ev_sim
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ev_sim {
+
+/**
+ * Hardware events counted by PerfCounters
+ */
+enum class PerfEvent {
+    Cycles = 0,
+    Instructions,
+    BranchMisses,
+    CacheMisses,     // Last-level cache misses
+    Count
+};
+
+const char* perfEventName(PerfEvent event);
+
+/**
+ * Counter values for one measured region
+ */
+struct PerfSample {
+    uint64_t value[static_cast<int>(PerfEvent::Count)] = {};
+    bool valid[static_cast<int>(PerfEvent::Count)] = {};
+
+    bool has(PerfEvent event) const { return valid[static_cast<int>(event)]; }
+    uint64_t get(PerfEvent event) const { return value[static_cast<int>(event)]; }
+};
+
+/**
+ * User-space hardware counters for the calling thread (Linux perf_event_open)
+ *
+ * Each event is opened on its own, so a PMU that lacks one event still
+ * reports the others. Counts are scaled when the kernel multiplexes
+ * counters. On other platforms, inside most containers or with a strict
+ * perf_event_paranoid, nothing opens: isAvailable() is false,
+ * unavailableReason() says why, and start()/stop() return empty samples.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * Whether at least one event could be opened
+     */
+    bool isAvailable() const;
+    bool isAvailable(PerfEvent event) const { return fds_[static_cast<int>(event)] >= 0; }
+    const std::string& unavailableReason() const { return reason_; }
+
+    /**
+     * Reset and start all open counters
+     */
+    void start();
+
+    /**
+     * Stop the counters and read them
+     */
+    PerfSample stop();
+
+private:
+    int fds_[static_cast<int>(PerfEvent::Count)];
+    std::string reason_;
+};
+
+} // namespace ev_sim
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace ev_sim {
+
+/**
+ * Scalar-generic physics core shared by Engine, Clutch and other backends
+ *
+ * Every formula is a function template on the scalar type T, so float (the
+ * Engine/Clutch classes), double (long batch runs), dual numbers
+ * (sensitivities, see dual.hpp) and SIMD lane types run the same source.
+ *
+ * Requirements on T: construction from float, + - * /, comparisons, and
+ * any/all/select/min/max/clamp/exp found either here (arithmetic types and
+ * bool masks) or by argument-dependent lookup next to T. Piecewise formulas
+ * go through choose(), which only evaluates the pieces some lane takes, so a
+ * lane type supplies masks from its comparisons plus any/all and a blend.
+ */
+namespace physics {
+
+// rad/s → RPM (also rad/s² → RPM/s)
+constexpr float kRadPerSecToRPM = 60.0f / (2.0f * 3.14159265358979323846f);
+
+// Rate of the first-order lag from target torque to output torque (1/s)
+constexpr float kTorqueResponse = 5.0f;
+
+// Idle governor recovery rate (1/s): 10% of the idle error per 100 ms step, -ln(0.9) / 0.1
+constexpr float kIdleRecoveryRate = 1.05360516f;
+
+// Driveline inertia added at full clutch engagement, as a multiple of the flywheel
+constexpr float kDrivelineInertiaMultiplier = 1.5f;
+
+// Locked clutch convergence rate (1/s): the original 80% per 100 ms step, -ln(0.2) / 0.1
+constexpr float kClutchLockedRate = 16.0943791f;
+
+// Disengaged transmission spin-down (1/s), ~3% per second
+constexpr float kCoastDecayRate = 0.03f;
+
+// Standard gravity (m/s²)
+constexpr float kGravity = 9.80665f;
+
+// Scalar operations for arithmetic types; other types overload these in their own namespace
+inline bool any(bool mask) { return mask; }
+inline bool all(bool mask) { return mask; }
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+inline T select(bool condition, T if_true, T if_false) { return condition ? if_true : if_false; }
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+inline T min(T a, T b) { return std::min(a, b); }
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+inline T max(T a, T b) { return std::max(a, b); }
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+inline T clamp(T value, T low, T high) { return std::clamp(value, low, high); }
+
+template <typename T, typename = std::enable_if_t<std::is_floating_point<T>::value>>
+inline T exp(T value) { return std::exp(value); }
+
+/**
+ * Lazy select: if_true() where mask holds, if_false() elsewhere
+ *
+ * A branch is only evaluated when some lane takes it, so lane types pay for
+ * both sides only when their lanes disagree. Scalar (bool) masks take the
+ * overload below.
+ */
+template <typename M, typename FT, typename FF>
+inline auto choose(const M& mask, FT if_true, FF if_false) -> decltype(if_true()) {
+    if (all(mask)) {
+        return if_true();
+    }
+    if (!any(mask)) {
+        return if_false();
+    }
+    return select(mask, if_true(), if_false());
+}
+
+/**
+ * Scalar choose: a plain branch, so float code compiles to the original
+ * if/else without the all/any tests
+ */
+template <typename FT, typename FF>
+inline auto choose(bool mask, FT if_true, FF if_false) -> decltype(if_true()) {
+    if (mask) {
+        return if_true();
+    }
+    return if_false();
+}
+
+/**
+ * Engine torque curve with engine braking and rev limiter
+ * @param throttle Throttle [0, 1] (already clamped)
+ */
+template <typename T>
+inline T engineTorque(const T& rpm, const T& throttle, const T& max_rpm, const T& max_torque) {
+    // Simplified torque curve: rise to mid‑range peak, then fall toward redline
+    const T rpm_ratio = rpm / max_rpm;
+    
+    const T torque_curve = choose(rpm_ratio < T(0.6f), [&] {
+        // Build up to peak torque - quadratic curve
+        return (rpm_ratio / T(0.6f)) * (T(2.0f) - rpm_ratio / T(0.6f)) * max_torque;
+    }, [&] {
+        return choose(rpm_ratio < T(0.85f), [&] {
+            // Maintain high torque in mid-range
+            return max_torque * (T(1.0f) - T(0.1f) * (rpm_ratio - T(0.6f)) / T(0.25f));
+        }, [&] {
+            // Gradual falloff toward redline
+            return max_torque * T(0.9f) * (T(1.0f) - rpm_ratio) / T(0.15f);
+        });
+    });
+    
+    // Engine braking when throttle is low, increasing with RPM (simple linear model)
+    const T engine_braking = select(throttle < T(0.1f), T(-20.0f) * rpm_ratio, T(0.0f));
+    
+    const T base_torque = torque_curve * throttle + engine_braking;
+    
+    // Rev limiter: linear reduction from 98% of max RPM to max RPM
+    const T rev_limit_start = T(0.98f) * max_rpm;
+    return choose(rpm >= rev_limit_start, [&] {
+        return base_torque * clamp((max_rpm - rpm) / (max_rpm - rev_limit_start), T(0.0f), T(1.0f));
+    }, [&] {
+        return base_torque;
+    });
+}
+
+/**
+ * Quadratic drag: -k * (rpm/1000)^2
+ */
+template <typename T>
+inline T engineDrag(const T& rpm, const T& drag_coefficient) {
+    const T rpm_thousands = rpm / T(1000.0f);
+    return -drag_coefficient * rpm_thousands * rpm_thousands;
+}
+
+/**
+ * Flywheel plus simulated driveline mass, interpolated by clutch engagement
+ */
+template <typename T>
+inline T effectiveInertia(const T& flywheel_inertia, const T& clutch_engagement) {
+    const T additional_inertia = flywheel_inertia * (T(kDrivelineInertiaMultiplier) - T(1.0f));
+    return flywheel_inertia + additional_inertia * clutch_engagement;
+}
+
+/**
+ * Idle governor (proportional, as a rate) and redline clamp
+ */
+template <typename T>
+inline T limitRPM(const T& rpm, const T& idle_rpm, const T& max_rpm, const T& dt) {
+    const T governed = choose(rpm < idle_rpm, [&] {
+        const T idle_correction = (idle_rpm - rpm) * (T(1.0f) - exp(T(-kIdleRecoveryRate) * dt));
+        return max(rpm + idle_correction, T(0.0f));
+    }, [&] {
+        return rpm;
+    });
+    return min(governed, max_rpm);
+}
+
+/**
+ * Fraction of the engine/transmission RPM gap closed in one step
+ * @param analytic true: exact 1 - exp(-k*dt); false: the original per-step factors
+ */
+template <typename T>
+inline T clutchConvergence(const T& engagement, const T& stiffness, const T& dt, bool analytic) {
+    if (analytic) {
+        const T rate = select(engagement == T(1.0f), T(kClutchLockedRate), engagement * stiffness);
+        return T(1.0f) - exp(-rate * dt);
+    }
+    // 80% per call when locked, engagement*stiffness*dt (clamped) while slipping
+    return select(engagement == T(1.0f), T(0.8f), clamp(engagement * stiffness * dt, T(0.0f), T(1.0f)));
+}
+
+/**
+ * Move both shafts toward their common RPM by the given fraction
+ * @param engine_share Engine weight in the common RPM, J_e / (J_e + J_t); 0.5 gives the plain average
+ */
+template <typename T>
+inline void clutchCouple(T& engine_rpm, T& transmission_rpm, const T& convergence, const T& engine_share) {
+    const T avg_rpm = engine_rpm * engine_share + transmission_rpm * (T(1.0f) - engine_share);
+    engine_rpm += (avg_rpm - engine_rpm) * convergence;
+    transmission_rpm += (avg_rpm - transmission_rpm) * convergence;
+}
+
+/**
+ * What one friction clutch step transmitted
+ */
+template <typename T>
+struct FrictionStep {
+    T impulse;                     // ∫T dt (N⋅m⋅s)
+    T heat;                        // ∫T * slip dt (J)
+    T event_time;                  // Lock-up or breakaway within the step (s), -1 if none
+};
+
+/**
+ * Advance both shafts through a friction clutch over one step
+ *
+ * Accelerations and torques are held over the step, so slip is linear in
+ * time and its zero crossing is exact; at zero slip the shafts stick if
+ * the static capacity holds them, otherwise they slip on in the direction
+ * of the excess. Scalar types only: the regime is a branch on the lock
+ * state of this one shaft pair.
+ *
+ * @param engine_gain Engine deceleration per Nm of clutch torque (RPM/s per Nm)
+ * @param transmission_gain Transmission acceleration per Nm of clutch torque (RPM/s per Nm)
+ * @param lock_slip Slip that counts as zero (RPM)
+ */
+template <typename T>
+inline FrictionStep<T> frictionStep(T& engine_rpm, T& transmission_rpm, bool& locked,
+                                    const T& engine_accel, const T& transmission_accel,
+                                    const T& engine_gain, const T& transmission_gain,
+                                    const T& kinetic_torque, const T& static_torque,
+                                    const T& dt, const T& lock_slip) {
+    // Clutch torque T (Nm) slows the engine by T*engine_gain and speeds the
+    // transmission by T*transmission_gain, so slip changes at free_slip_rate - T*coupling
+    const T coupling = engine_gain + transmission_gain;
+    const T free_slip_rate = engine_accel - transmission_accel;
+
+    // Torque that keeps the shafts together: equal accelerations
+    const T stick_torque = free_slip_rate / coupling;
+
+    FrictionStep<T> result = { T(0.0f), T(0.0f), T(-1.0f) };
+    T time_left = dt;
+
+    // Advance both shafts for `duration` under clutch torque `torque`
+    auto advance = [&](const T& torque, const T& duration) {
+        const T slip_start = engine_rpm - transmission_rpm;
+        engine_rpm += (engine_accel - torque * engine_gain) * duration;
+        transmission_rpm += (transmission_accel + torque * transmission_gain) * duration;
+        const T slip_end = engine_rpm - transmission_rpm;
+        result.impulse += torque * duration;
+        result.heat += torque * T(0.5f) * (slip_start + slip_end) / T(kRadPerSecToRPM) * duration;
+    };
+
+    T slip = engine_rpm - transmission_rpm;
+    if (locked && std::fabs(slip) > lock_slip) {
+        locked = false;    // Shafts moved apart outside the solver (e.g. setRPM)
+    }
+
+    if (!locked && std::fabs(slip) > lock_slip) {
+        // Kinetic friction opposes the slip
+        const T kinetic = slip > T(0.0f) ? kinetic_torque : -kinetic_torque;
+        const T slip_rate = free_slip_rate - kinetic * coupling;
+        const T crossing = slip_rate * slip < T(0.0f) ? -slip / slip_rate : dt;
+
+        if (crossing >= dt) {
+            advance(kinetic, dt);
+            time_left = T(0.0f);
+        } else {
+            advance(kinetic, crossing);
+            time_left = dt - crossing;
+            result.event_time = crossing;
+            slip = T(0.0f);
+        }
+    }
+
+    if (time_left > T(0.0f)) {
+        // Zero slip: stick if the static capacity can hold the shafts together
+        const T common_rpm = (engine_rpm * transmission_gain + transmission_rpm * engine_gain) / coupling;
+        engine_rpm = common_rpm;
+        transmission_rpm = common_rpm;
+
+        if (std::fabs(stick_torque) <= static_torque) {
+            locked = true;
+            advance(stick_torque, time_left);
+            transmission_rpm = engine_rpm;    // Hold exactly; rounding would reopen the slip
+        } else {
+            // Demand exceeds capacity: slip opens in the direction of the excess
+            if (locked && result.event_time < T(0.0f)) {
+                result.event_time = T(0.0f);
+            }
+            locked = false;
+            advance(stick_torque > T(0.0f) ? kinetic_torque : -kinetic_torque, time_left);
+        }
+    }
+
+    transmission_rpm = std::max(transmission_rpm, T(0.0f));
+    return result;
+}
+
+/**
+ * Per-step decay factor of a disengaged transmission
+ */
+template <typename T>
+inline T coastFactor(const T& dt, bool analytic) {
+    return analytic ? exp(T(-kCoastDecayRate) * dt) : T(1.0f) - T(kCoastDecayRate) * dt;
+}
+
+/**
+ * Road load opposing forward motion: grade and rolling resistance plus aero drag
+ * @param constant_force Speed-independent part, m * g * (Crr * cos + sin) of the grade (N)
+ * @param aero_coefficient 0.5 * air density * Cd * A (N per (m/s)²)
+ */
+template <typename T>
+inline T roadLoadForce(const T& speed, const T& constant_force, const T& aero_coefficient) {
+    return constant_force + aero_coefficient * speed * speed;
+}
+
+/**
+ * Vehicle speed after one step of the longitudinal equation
+ *
+ *   m_eff * dv/dt = wheel_torque / r - constant_force - aero * v²
+ *
+ * Aero drag is linearized around the current speed and taken implicitly,
+ * so the step is stable at any dt and costs one division. Forward motion
+ * only: a vehicle the drive cannot move (or hold on a climb) stays at rest.
+ * Straight-line arithmetic, so batches of vehicles vectorize.
+ *
+ * @param inv_radius 1 / wheel radius (1/m)
+ * @param inv_mass 1 / (mass + wheel inertia / r²) (1/kg)
+ */
+template <typename T>
+inline T vehicleSpeedStep(const T& speed, const T& wheel_torque, const T& inv_radius, const T& inv_mass,
+                          const T& constant_force, const T& aero_coefficient, const T& dt) {
+    const T accel = (wheel_torque * inv_radius - constant_force) * inv_mass;
+    const T drag_rate = aero_coefficient * speed * inv_mass;
+    return max((speed + accel * dt) / (T(1.0f) + drag_rate * dt), T(0.0f));
+}
+
+} // namespace physics
+} // namespace ev_sim
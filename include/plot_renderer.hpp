@@ -0,0 +1,130 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Time-series plot renderer with GPU-resident sample buffers
+ *
+ * Each channel is a fixed-size ring of samples (oldest on the left, newest
+ * on the right). With a GL context, every channel lives in its own vertex
+ * buffer; push() only marks samples dirty and the draw callback uploads the
+ * new ones with glBufferSubData before drawing the ring as line strips with
+ * a small shader. Without GL (or if shader setup fails) the same API falls
+ * back to one ImDrawList polyline per channel.
+ */
+class PlotRenderer {
+public:
+    // OpenGL function loader, e.g. SDL_GL_GetProcAddress
+    typedef void (*GLProc)(void);
+    typedef GLProc (*GLProcLoader)(const char* name);
+
+    /**
+     * Constructor
+     * @param capacity Samples per channel (the visible window)
+     */
+    explicit PlotRenderer(int capacity);
+    ~PlotRenderer();
+
+    PlotRenderer(const PlotRenderer&) = delete;
+    PlotRenderer& operator=(const PlotRenderer&) = delete;
+
+    /**
+     * Create GL resources; requires the GL context to be current
+     * @param loader Function used to resolve GL 3.3 entry points
+     * @return False if the GPU path is unavailable (CPU fallback stays active)
+     */
+    bool initGL(GLProcLoader loader);
+
+    /**
+     * Release GL resources; requires the GL context to be current
+     */
+    void shutdownGL();
+
+    /**
+     * Add a channel, filled with an initial value
+     * @param color Line color
+     * @param min_value Value mapped to the bottom of the plot
+     * @param max_value Value mapped to the top of the plot
+     * @param initial_value Value of all samples before the first push
+     * @param thickness Line thickness in pixels
+     * @return Channel index
+     */
+    int addChannel(ImU32 color, float min_value, float max_value, float initial_value = 0.0f, float thickness = 2.0f);
+
+    /**
+     * Append a sample, overwriting the oldest one
+     */
+    void push(int channel, float value);
+
+    /**
+     * Reserve a plot area at the cursor and draw the given channels into it
+     * @param id ImGui item ID
+     * @param size Plot size (negative/zero components stretch like other ImGui widgets)
+     * @param channels Channel indices to draw, in order (later ones on top)
+     * @param channel_count Number of channel indices, any number
+     * @param background Background fill (0 = none)
+     */
+    void draw(const char* id, ImVec2 size, const int* channels, int channel_count, ImU32 background);
+
+    /**
+     * Draw the given channels into an explicit screen rectangle of the current window
+     */
+    void drawInRect(const ImVec2& rect_min, const ImVec2& rect_max, const int* channels, int channel_count);
+
+    // Sample access in chronological order (0 = oldest)
+    float sample(int channel, int index) const;
+    float latest(int channel) const;
+
+    int getCapacity() const { return capacity_; }
+    int getChannelCount() const { return static_cast<int>(channels_.size()); }
+    bool isGpuEnabled() const { return gpu_enabled_; }
+    void setGpuEnabled(bool enabled) { gpu_enabled_ = enabled && gl_ready_; }
+
+private:
+    struct Channel {
+        std::vector<float> samples;   // CPU shadow, capacity + 1 (last slot mirrors slot 0)
+        int head = 0;                 // Next write slot == oldest sample
+        uint64_t written = 0;         // Total samples pushed
+        uint64_t uploaded = 0;        // Samples already mirrored to the GPU
+        ImU32 color = 0;
+        float min_value = 0.0f;
+        float max_value = 1.0f;
+        float thickness = 1.0f;
+        unsigned int vbo = 0;
+    };
+
+    // Per-callback payload, passed by pointer through the plain
+    // AddCallback(cb, ptr) overload; a draw with more channels is split over
+    // several callbacks
+    static constexpr int kMaxChannelsPerDraw = 8;
+    struct DrawCall {
+        PlotRenderer* renderer;
+        ImVec2 rect_min;
+        ImVec2 rect_max;
+        int channel_count;
+        int channels[kMaxChannelsPerDraw];
+    };
+
+    static void renderCallback(const ImDrawList* parent_list, const ImDrawCmd* cmd);
+    void renderGL(const DrawCall& call, const ImDrawCmd* cmd);
+    void uploadPending(Channel& channel);
+    void drawCPU(ImDrawList* draw_list, const ImVec2& rect_min, const ImVec2& rect_max, const int* channels, int channel_count);
+
+    int capacity_;
+    std::vector<Channel> channels_;
+    std::vector<ImVec2> polyline_;    // Scratch points for the CPU path
+    std::deque<DrawCall> draw_calls_; // Payloads of the frame being built (a deque keeps them in place as it grows)
+    int draw_calls_frame_;            // ImGui frame they belong to; the next frame's first draw recycles them
+
+    bool gl_ready_;
+    bool gpu_enabled_;
+    struct GLState;
+    GLState* gl_;
+};
+
+} // namespace ev_sim
@@ -0,0 +1,148 @@
+#pragma once
+
+// Set to 0 (CMake: -DEV_SIM_ENABLE_PROFILER=OFF) to compile the profiler out entirely
+#ifndef EV_SIM_PROFILER
+#define EV_SIM_PROFILER 1
+#endif
+
+#if EV_SIM_PROFILER
+
+#include <chrono>
+#include <cstdint>
+
+namespace ev_sim {
+
+/**
+ * Main-loop phases tracked by the frame profiler, in loop order
+ */
+enum class ProfilePhase {
+    EventPoll = 0,    // SDL event pump
+    Input,            // Gamepad read
+    Physics,          // Fixed-step drivetrain update
+    ImGuiBuild,       // NewFrame .. Render
+    GLRender,         // Clear + ImGui_ImplOpenGL3_RenderDrawData
+    Swap,             // SDL_GL_SwapWindow
+    Idle,             // Frame pacing wait
+    Count
+};
+
+const char* profilePhaseName(ProfilePhase phase);
+
+/**
+ * Timing of one completed frame
+ */
+struct FrameRecord {
+    float phase_ms[static_cast<int>(ProfilePhase::Count)] = {};
+    float total_ms = 0.0f;
+    uint64_t frame_index = 0;
+};
+
+/**
+ * Low-overhead frame phase profiler
+ *
+ * Phases are laps: mark() closes the running phase and opens the next, so a
+ * frame costs one clock read per phase. Completed frames and physics step
+ * times go into fixed-size rings; nothing allocates after construction.
+ */
+class FrameProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int kHistory = 240;       // Frames kept for the rolling view
+    static constexpr int kPhysicsHistory = 120; // Physics steps kept for the rolling view
+
+    FrameProfiler();
+
+    /**
+     * Open a frame; the first phase is EventPoll
+     */
+    void beginFrame();
+
+    /**
+     * Close the running phase and start another
+     */
+    void mark(ProfilePhase phase);
+
+    /**
+     * Close the frame and commit it to the history
+     */
+    void endFrame();
+
+    /**
+     * Drop the open frame (e.g. iterations that skip rendering)
+     */
+    void cancelFrame();
+
+    /**
+     * Record the duration of one physics step
+     * @param seconds Wall time of the step
+     */
+    void recordPhysicsStep(double seconds);
+
+    // History access: index 0 = oldest, count() - 1 = newest
+    int frameCount() const { return frame_count_; }
+    const FrameRecord& frame(int index) const;
+    int physicsCount() const { return physics_count_; }
+    float physicsStepMs(int index) const;
+
+    // Worst frame seen since the last reset
+    const FrameRecord& worstFrame() const { return worst_frame_; }
+    void resetWorst() { worst_frame_ = FrameRecord(); }
+
+    uint64_t totalFrames() const { return total_frames_; }
+
+private:
+    FrameRecord frames_[kHistory];
+    int frame_head_;
+    int frame_count_;
+
+    float physics_ms_[kPhysicsHistory];
+    int physics_head_;
+    int physics_count_;
+
+    FrameRecord current_;
+    ProfilePhase current_phase_;
+    Clock::time_point phase_start_;
+    bool frame_open_;
+
+    FrameRecord worst_frame_;
+    uint64_t total_frames_;
+};
+
+/**
+ * Times a physics step into the profiler
+ */
+class ScopedPhysicsTimer {
+public:
+    explicit ScopedPhysicsTimer(FrameProfiler& profiler)
+        : profiler_(profiler), start_(FrameProfiler::Clock::now()) {}
+    ~ScopedPhysicsTimer() {
+        profiler_.recordPhysicsStep(
+            std::chrono::duration<double>(FrameProfiler::Clock::now() - start_).count());
+    }
+
+    ScopedPhysicsTimer(const ScopedPhysicsTimer&) = delete;
+    ScopedPhysicsTimer& operator=(const ScopedPhysicsTimer&) = delete;
+
+private:
+    FrameProfiler& profiler_;
+    FrameProfiler::Clock::time_point start_;
+};
+
+} // namespace ev_sim
+
+#define EV_SIM_PROFILE_BEGIN_FRAME(profiler) (profiler).beginFrame()
+#define EV_SIM_PROFILE_MARK(profiler, phase) (profiler).mark(phase)
+#define EV_SIM_PROFILE_END_FRAME(profiler) (profiler).endFrame()
+#define EV_SIM_PROFILE_CANCEL_FRAME(profiler) (profiler).cancelFrame()
+#define EV_SIM_PROFILE_PHYSICS_STEP(profiler) ev_sim::ScopedPhysicsTimer ev_sim_physics_timer_(profiler)
+
+#else
+
+#define EV_SIM_PROFILE_BEGIN_FRAME(profiler) ((void)0)
+#define EV_SIM_PROFILE_MARK(profiler, phase) ((void)0)
+#define EV_SIM_PROFILE_END_FRAME(profiler) ((void)0)
+#define EV_SIM_PROFILE_CANCEL_FRAME(profiler) ((void)0)
+#define EV_SIM_PROFILE_PHYSICS_STEP(profiler) ((void)0)
+
+#endif // EV_SIM_PROFILER
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "profiler.hpp"
+
+#if EV_SIM_PROFILER
+
+#include <imgui.h>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Dashboard window showing FrameProfiler data
+ *
+ * Per-phase timings, rolling frame-time bars with the worst frames marked,
+ * rolling physics step times and the vertex/index counts of every draw list
+ * submitted in the previous frame.
+ */
+class ProfilerPanel {
+public:
+    ProfilerPanel();
+
+    /**
+     * Snapshot draw-list sizes; call right after ImGui::Render()
+     */
+    void captureDrawData(const ImDrawData* draw_data);
+
+    /**
+     * Build the profiler window
+     */
+    void draw(const FrameProfiler& profiler);
+
+private:
+    struct DrawListStats {
+        const char* owner;       // Window name (owned by ImGui, valid while the window exists)
+        int vtx_count;
+        int idx_count;
+        int cmd_count;
+    };
+
+    void drawFrameBars(const FrameProfiler& profiler, float scale_ms);
+
+    std::vector<DrawListStats> draw_lists_;
+    int total_vtx_;
+    int total_idx_;
+    float budget_ms_;            // Frame budget line (60 Hz)
+    float panel_build_ms_;       // Cost of building this panel last frame
+};
+
+} // namespace ev_sim
+
+#endif // EV_SIM_PROFILER
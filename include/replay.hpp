@@ -0,0 +1,88 @@
+#pragma once
+
+#include "adaptive_stepper.hpp"
+#include "drive_cycle.hpp"
+#include "driver_model.hpp"
+#include "drivetrain.hpp"
+#include "fast_forward.hpp"
+#include "input_loader.hpp"
+#include <ostream>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * One row of fixed-interval telemetry
+ */
+struct TelemetrySample {
+    double time;                   // Seconds from the start of the drive
+    float engine_rpm;
+    float transmission_rpm;
+    float output_rpm;              // Gearbox output shaft
+    int gear;                      // Engaged gear, 0 = neutral
+    float speed_kmh;               // Vehicle road speed
+    float clutch_engagement;       // [0.0, 1.0]
+    float clutch_torque;           // Nm, Friction solver only
+    float throttle_percent;
+    float clutch_pedal_percent;
+};
+
+/**
+ * How replay() advances the drivetrain
+ */
+enum class StepMode {
+    Fixed = 0,      // Constant dt (shortened only to land on input changes)
+    Adaptive,       // AdaptiveStepper with error control
+    Count
+};
+
+const char* stepModeName(StepMode mode);
+
+struct ReplayOptions {
+    StepMode mode = StepMode::Fixed;
+    double dt = 0.01;              // Fixed mode step (s)
+    AdaptiveStepOptions adaptive;  // Adaptive mode settings
+    double grid_dt = 0.1;          // Telemetry interval (s)
+    FastForwardOptions fast_forward; // Jump over steady stretches
+};
+
+/**
+ * Drive the drivetrain through an input trace
+ *
+ * Steps never straddle an input change; each input sample's gear is
+ * requested from the gearbox when it takes effect. Telemetry is resampled onto the
+ * fixed grid_dt grid by linear interpolation between step end points, so
+ * fixed and adaptive runs produce directly comparable rows whatever steps
+ * they took.
+ *
+ * With fast_forward enabled, a segment whose state has settled (see
+ * SteadyStateDetector) is finished in closed form; telemetry rows inside
+ * the jump are evaluated from the closed form rather than interpolated.
+ *
+ * @param telemetry Receives one sample per grid point from t = 0 (may be null)
+ * @return Step statistics
+ */
+StepCounts replay(Drivetrain& drivetrain, const InputTrace& trace, const ReplayOptions& options,
+                  std::vector<TelemetrySample>* telemetry);
+
+/**
+ * Drive the drivetrain through a speed cycle with a closed-loop driver
+ *
+ * The driver's commands replace the input trace, so headless runs get
+ * throttle, clutch, gear and brake inputs without a recording. Steps are
+ * fixed at options.dt (the driver runs once per step; mode and fast
+ * forward do not apply) and telemetry is resampled as in replay(), with
+ * the driver's pedal positions as the inputs.
+ *
+ * @param telemetry Receives one sample per grid point from t = 0 (may be null)
+ * @return Step statistics
+ */
+StepCounts driveCycle(Drivetrain& drivetrain, DriverModel& driver, const DriveCycle& cycle,
+                      const ReplayOptions& options, std::vector<TelemetrySample>* telemetry);
+
+/**
+ * Write telemetry as CSV with a header row
+ */
+void writeTelemetryCsv(std::ostream& out, const std::vector<TelemetrySample>& telemetry);
+
+} // namespace ev_sim
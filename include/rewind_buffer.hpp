@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Fixed-capacity ring of snapshots, newest last
+ *
+ * All storage is allocated up front; push() overwrites the oldest entry
+ * once the ring is full, so recording never allocates and the memory is
+ * capacity × sizeof(T) for the whole session. Entries are addressed
+ * backwards from the newest (0 = newest). dropNewest() discards the most
+ * recent entries, e.g. the future abandoned when driving on from a
+ * rewound point.
+ */
+template <typename T>
+class RewindBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "snapshots are plain data");
+
+public:
+    explicit RewindBuffer(size_t capacity)
+        : entries_(capacity > 0 ? capacity : 1)
+        , head_(0)
+        , size_(0)
+    {
+    }
+
+    void push(const T& entry) {
+        entries_[head_] = entry;
+        head_ = head_ + 1 == entries_.size() ? 0 : head_ + 1;
+        if (size_ < entries_.size()) {
+            size_++;
+        }
+    }
+
+    /**
+     * @param back Entries before the newest, in [0, size())
+     */
+    const T& fromNewest(size_t back) const {
+        assert(back < size_);
+        const size_t capacity = entries_.size();
+        return entries_[(head_ + capacity - 1 - back) % capacity];
+    }
+
+    const T& newest() const { return fromNewest(0); }
+
+    void dropNewest(size_t count) {
+        count = count < size_ ? count : size_;
+        head_ = (head_ + entries_.size() - count) % entries_.size();
+        size_ -= count;
+    }
+
+    void clear() { head_ = 0; size_ = 0; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return entries_.size(); }
+    size_t memoryBytes() const { return entries_.size() * sizeof(T); }
+
+private:
+    std::vector<T> entries_;
+    size_t head_;                  // Next slot to write
+    size_t size_;
+};
+
+} // namespace ev_sim
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "cycle_runner.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Bounds and resolution of the shift schedule search
+ *
+ * The variables are the upshift RPM out of each gear but the top one, the
+ * launch clutch release time and the post-shift release time. Each is
+ * searched on a grid of the given step, so nearby points from different
+ * searches land on the same schedule and are simulated once.
+ */
+struct ShiftSearchSpace {
+    float min_upshift_rpm = 2200.0f;
+    float max_upshift_rpm = 6500.0f;
+    float rpm_step = 100.0f;
+    float min_launch_time = 0.5f;      // s
+    float max_launch_time = 3.0f;
+    float min_release_time = 0.2f;     // s
+    float max_release_time = 1.0f;
+    float time_step = 0.05f;           // s
+};
+
+/**
+ * Shift optimizer settings
+ */
+struct ShiftOptimizerOptions {
+    ShiftSearchSpace space;
+    CycleOptions cycle;
+    int weights = 8;                   // Time/energy trade-offs searched, endpoints included
+    int evaluations_per_weight = 120;  // Nelder-Mead budget per trade-off (cache hits count)
+    int initial_samples = 32;          // Latin hypercube points shared by every search
+    float target_kmh = 100.0f;         // Acceleration run end speed
+    double time_limit = 60.0;          // Acceleration run limit (s)
+    double max_rms_error = 2.5;        // Cycle tracking error above which a schedule is infeasible (km/h)
+    uint32_t seed = 1;
+};
+
+/**
+ * One evaluated schedule and its objectives
+ */
+struct ShiftCandidate {
+    ShiftSchedule schedule;
+    double acceleration_time = 0.0;    // 0 to target speed (s)
+    double wh_per_km = 0.0;            // Battery energy over the cycles per distance driven
+    double rms_speed_error = 0.0;      // Worst cycle (km/h)
+    bool feasible = false;             // Reached the target speed and tracked every cycle
+};
+
+/**
+ * Optimizer output and work counters
+ */
+struct ShiftOptimizerResult {
+    ShiftCandidate baseline;                  // The base configuration's own schedule, snapped to the grid
+    std::vector<ShiftCandidate> evaluated;    // Every distinct schedule simulated
+    std::vector<ShiftCandidate> front;        // Feasible, non-dominated, fastest first
+    size_t evaluations = 0;                   // Objective requests from the searches
+    size_t simulations = 0;                   // Requests that ran the simulation
+    size_t cache_hits = 0;                    // Requests answered by an earlier simulation
+};
+
+/**
+ * Multi-objective search over the shift schedule: 0-to-target time
+ * against cycle energy
+ *
+ * A Latin hypercube seeds the objective ranges, then one Nelder-Mead
+ * search per weight minimizes the augmented Chebyshev scalarization
+ *   max_i w_i f̂_i + ρ Σ_i f̂_i
+ * of the normalized objectives, which reaches non-convex parts of the front
+ * that a weighted sum cannot. The searches run in parallel on the pool
+ * and share one cache of simulated schedules, so a point any search has
+ * visited costs a map lookup; a request for a point another thread is still
+ * simulating waits for that result instead of repeating it. The front is
+ * taken over every feasible schedule simulated, not only the searches' ends.
+ */
+class ShiftOptimizer {
+public:
+    /**
+     * @param base Vehicle to tune; its schedule's downshift RPM is kept
+     * @param cycles Cycles the energy objective is measured on
+     */
+    ShiftOptimizer(const CycleConfig& base, const std::vector<DriveCycle>& cycles,
+                   const ShiftOptimizerOptions& options = ShiftOptimizerOptions());
+
+    ShiftOptimizerResult run(ThreadPool& pool);
+
+    int dimensions() const { return dimensions_; }
+
+private:
+    CycleConfig base_;
+    std::vector<DriveCycle> cycles_;
+    ShiftOptimizerOptions options_;
+    int dimensions_;
+};
+
+/**
+ * Feasible candidates not dominated in (acceleration time, Wh/km), fastest
+ * first; of equal points the first is kept
+ */
+std::vector<ShiftCandidate> paretoFront(const std::vector<ShiftCandidate>& candidates);
+
+} // namespace ev_sim
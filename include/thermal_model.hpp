@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+
+namespace ev_sim {
+
+/**
+ * Lumped thermal parameters of an engine/motor and its cooling loop
+ */
+struct ThermalParameters {
+    float ambient_c = 25.0f;              // Ambient air (°C)
+    float initial_c = 80.0f;              // Starting temperature (°C)
+    float heat_capacity = 60000.0f;       // Block + coolant (J/K)
+    float heat_fraction = 0.6f;           // Heat into the cooling loop per watt of shaft power
+    float base_conductance = 50.0f;       // Convection to ambient, always active (W/K)
+    float radiator_conductance = 1500.0f; // Radiator above the thermostat (W/K per K over it)
+    float thermostat_c = 90.0f;           // Thermostat opening temperature (°C)
+    float derate_start_c = 110.0f;        // Full torque up to here (°C)
+    float derate_end_c = 130.0f;          // Derating reaches min_derate here (°C)
+    float min_derate = 0.3f;              // Torque fraction left when fully derated
+};
+
+/**
+ * Everything a ThermalModel changes while running (parameters excluded)
+ */
+struct ThermalState {
+    float temperature;             // °C
+    float heat_input_w;            // W
+    float pending_energy;          // J
+};
+
+/**
+ * Lumped-capacitance thermal model with torque derating
+ *
+ * Split into a feeding and an advancing half so it can run at its own
+ * rate: heat is added with addHeat() from every physics step, so
+ * throttle transients between thermal updates are integrated rather than
+ * aliased, while update() runs at the thermal rate, turns the
+ * accumulated energy into an average heat input and advances the
+ * temperature. With the heat input held over the
+ * update the temperature has a closed form on each side of the thermostat,
+ *   T(t) = T_eq + (T0 - T_eq) * exp(-G * t / C),
+ * so the result does not depend on the thermal rate; a thermostat crossing
+ * inside the interval is located exactly and the remainder continues in
+ * the other regime.
+ */
+class ThermalModel {
+public:
+    explicit ThermalModel(const ThermalParameters& params = ThermalParameters());
+
+    /**
+     * Accumulate heat from the fast loop
+     * @param shaft_power_w Mechanical output power (W); negative (motoring) adds none
+     * @param dt Step duration (seconds)
+     */
+    void addHeat(float shaft_power_w, float dt) {
+        // Branch-free: the sign flips with every lift-off
+        pending_energy_ += std::max(shaft_power_w, 0.0f) * params_.heat_fraction * dt;
+    }
+
+    /**
+     * Advance the temperature over the heat accumulated since the last update
+     * @param dt Time since the last update (seconds)
+     */
+    void update(float dt);
+
+    /**
+     * Torque multiplier for the current temperature [min_derate, 1]
+     */
+    float getTorqueDerate() const;
+
+    float getTemperature() const { return temperature_; }
+    float getHeatInput() const { return heat_input_w_; }   // Average of the last update (W)
+    const ThermalParameters& getParameters() const { return params_; }
+
+    void setTemperature(float temperature) { temperature_ = temperature; }
+
+    ThermalState snapshot() const { return { temperature_, heat_input_w_, pending_energy_ }; }
+    void restore(const ThermalState& state) {
+        temperature_ = state.temperature;
+        heat_input_w_ = state.heat_input_w;
+        pending_energy_ = state.pending_energy;
+    }
+
+private:
+    ThermalParameters params_;
+
+    float temperature_;            // °C
+    float heat_input_w_;           // Average heat input over the last update (W)
+    float pending_energy_;         // Heat added since the last update (J); emptied every update, so float suffices
+};
+
+} // namespace ev_sim
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Fixed set of worker threads for data-parallel batches
+ *
+ * parallelFor() hands out indices one at a time from a shared counter, so
+ * long and short jobs balance themselves; the calling thread works too and
+ * returns once every index is done. Workers sleep between batches. Jobs
+ * must not share mutable state (each writes its own result slot).
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Total threads including the caller; 0 = one per hardware thread
+     */
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Run job(i) for every i in [0, count) and wait for all of them
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& job);
+
+    int threadCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+private:
+    void workerLoop();
+    void drain();    // Take and run indices until none are left
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    // Current batch (guarded by mutex_ except the counters)
+    const std::function<void(size_t)>* job_;
+    size_t count_;
+    std::atomic<size_t> next_;
+    std::atomic<size_t> finished_;
+    unsigned generation_;          // Bumped per batch so workers join each one once
+    int busy_;                     // Workers inside the current batch
+    bool stop_;
+};
+
+} // namespace ev_sim
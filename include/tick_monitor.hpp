@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Fixed-rate tick schedule with bounded catch-up
+ *
+ * Ticks are due at t0 + k * period, independent of when they actually ran,
+ * so the rate does not drift with frame time. poll() returns how many ticks
+ * are due; when the caller has fallen more than max_catch_up ticks behind,
+ * the excess ticks are dropped and the schedule skips ahead.
+ */
+class TickScheduler {
+public:
+    /**
+     * Constructor
+     * @param period Tick period (seconds)
+     * @param max_catch_up Maximum ticks returned by one poll()
+     */
+    explicit TickScheduler(double period, int max_catch_up = 5);
+
+    /**
+     * Restart the schedule; the first tick is due one period after now
+     */
+    void reset(double now);
+
+    /**
+     * Claim the ticks due at time now
+     * @return Number of ticks to run, 0..max_catch_up
+     */
+    int poll(double now);
+
+    /**
+     * Scheduled time of the i-th tick returned by the last poll()
+     */
+    double scheduledTime(int i) const { return batch_start_ + i * period_; }
+
+    double nextDue() const { return next_due_; }
+    double getPeriod() const { return period_; }
+    int lastDropped() const { return last_dropped_; }   // Ticks skipped by the last poll()
+
+private:
+    double period_;
+    int max_catch_up_;
+    double next_due_;
+    double batch_start_;
+    int last_dropped_;
+};
+
+/**
+ * Timing of one executed tick
+ */
+struct TickRecord {
+    double scheduled;        // When the tick was due (seconds)
+    double actual;           // When it ran (seconds)
+    float lateness_ms;       // actual - scheduled
+    int batch_size;          // Ticks run back-to-back in the same poll (1 = on time)
+};
+
+/**
+ * Lateness summary; percentiles cover the history window, the rest the whole run
+ */
+struct TickStats {
+    uint64_t ticks;
+    uint64_t caught_up;      // Ticks that ran in a batch of more than one
+    uint64_t dropped;        // Ticks skipped entirely
+    float mean_ms;
+    float jitter_ms;         // Standard deviation of lateness
+    float p50_ms;
+    float p99_ms;
+    float max_ms;
+};
+
+/**
+ * Real-time requirements for a tick stream; negative limits are not checked
+ */
+struct TickSla {
+    float p99_lateness_ms = 5.0f;
+    float max_lateness_ms = 20.0f;
+    int64_t max_dropped = 0;
+};
+
+/**
+ * Records scheduled vs. actual time of every tick
+ *
+ * Keeps the last kHistory ticks for percentiles and plots, plus a lateness
+ * histogram and running totals over the whole run. The last histogram bin
+ * collects everything beyond the range.
+ */
+class TickMonitor {
+public:
+    static constexpr int kHistory = 1000;
+    static constexpr int kHistogramBins = 25;
+
+    /**
+     * Constructor
+     * @param bin_ms Histogram bin width (milliseconds)
+     */
+    explicit TickMonitor(float bin_ms = 1.0f);
+
+    /**
+     * Record one executed tick
+     * @param batch_size Ticks run in the same poll
+     */
+    void recordTick(double scheduled, double actual, int batch_size);
+
+    /**
+     * Count ticks skipped by the scheduler
+     */
+    void recordDropped(int count);
+
+    void reset();
+
+    // History access: index 0 = oldest
+    int count() const { return count_; }
+    const TickRecord& tick(int index) const;
+
+    const uint64_t* histogram() const { return histogram_; }
+    float getBinMs() const { return bin_ms_; }
+
+    TickStats stats() const;
+
+    /**
+     * Check the run so far against an SLA
+     * @param violation Receives a description of the first failed limit
+     */
+    bool meetsSla(const TickSla& sla, std::string* violation = nullptr) const;
+
+private:
+    float bin_ms_;
+    TickRecord ticks_[kHistory];
+    int head_;
+    int count_;
+
+    uint64_t histogram_[kHistogramBins];
+    uint64_t total_ticks_;
+    uint64_t caught_up_;
+    uint64_t dropped_;
+    double lateness_sum_;
+    double lateness_sq_sum_;
+    float max_lateness_ms_;
+
+    mutable std::vector<float> scratch_;   // Percentile workspace
+};
+
+} // namespace ev_sim
@@ -0,0 +1,149 @@
+#pragma once
+
+// Set to 0 (CMake: -DEV_SIM_ENABLE_TRACE=OFF) to compile all trace zones out
+#ifndef EV_SIM_TRACE
+#define EV_SIM_TRACE 1
+#endif
+
+#if EV_SIM_TRACE
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * One closed zone; times are steady-clock nanoseconds since the recorder epoch
+ */
+struct TraceEvent {
+    const char* name;        // Must outlive the recorder (string literals)
+    const char* category;
+    int64_t begin_ns;
+    int64_t end_ns;
+};
+
+/**
+ * Process-wide recorder for scoped trace zones
+ *
+ * Every thread writes into its own fixed-size ring, so recording never
+ * contends with other threads; the per-buffer lock is only shared with an
+ * export in progress. Rings keep the newest events and outlive their thread.
+ * Recording is off until setEnabled(true); a disabled zone costs one
+ * relaxed atomic load.
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t kEventsPerThread = size_t(1) << 16;
+
+    static TraceRecorder& instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * Current time in nanoseconds since the recorder epoch
+     */
+    int64_t now() const;
+
+    /**
+     * Append a closed zone to the calling thread's ring
+     */
+    void record(const char* name, const char* category, int64_t begin_ns, int64_t end_ns);
+
+    /**
+     * Label the calling thread in exported traces
+     */
+    void setThreadName(const char* name);
+
+    /**
+     * Drop all recorded events (thread names are kept)
+     */
+    void clear();
+
+    /**
+     * Write zones overlapping [begin_ns, end_ns] as Chrome trace-event JSON
+     * (loadable in chrome://tracing and Perfetto)
+     * @return Number of zones written
+     */
+    size_t writeChromeTrace(std::ostream& out, int64_t begin_ns, int64_t end_ns) const;
+
+    /**
+     * Export the last window_seconds of zones to a file
+     * @return Number of zones written, or -1 if the file could not be opened
+     */
+    long exportChromeTrace(const std::string& path, double window_seconds) const;
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;   // Ring, allocated on first record
+        size_t head = 0;
+        size_t count = 0;
+        uint32_t thread_id = 0;
+        std::string thread_name;
+    };
+
+    TraceRecorder();
+    ThreadBuffer& threadBuffer();
+
+    std::atomic<bool> enabled_;
+    int64_t epoch_ns_;
+
+    mutable std::mutex registry_mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * RAII trace zone: records [construction, destruction) when tracing is on
+ *
+ * end() closes the zone early, for phases that do not map to a C++ scope.
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name, const char* category = "sim")
+        : name_(name)
+        , category_(category)
+        , begin_ns_(TraceRecorder::instance().isEnabled() ? TraceRecorder::instance().now() : -1)
+    {
+    }
+
+    ~TraceZone() { end(); }
+
+    void end() {
+        if (begin_ns_ >= 0) {
+            TraceRecorder& recorder = TraceRecorder::instance();
+            recorder.record(name_, category_, begin_ns_, recorder.now());
+            begin_ns_ = -1;
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    int64_t begin_ns_;       // -1 when not recording
+};
+
+} // namespace ev_sim
+
+#define EV_SIM_TRACE_CONCAT_(a, b) a##b
+#define EV_SIM_TRACE_CONCAT(a, b) EV_SIM_TRACE_CONCAT_(a, b)
+#define EV_SIM_TRACE_ZONE(name, category) \
+    ev_sim::TraceZone EV_SIM_TRACE_CONCAT(ev_sim_trace_zone_, __LINE__)(name, category)
+#define EV_SIM_TRACE_ZONE_NAMED(var, name, category) ev_sim::TraceZone var(name, category)
+#define EV_SIM_TRACE_ZONE_END(var) (var).end()
+
+#else
+
+#define EV_SIM_TRACE_ZONE(name, category) ((void)0)
+#define EV_SIM_TRACE_ZONE_NAMED(var, name, category) ((void)0)
+#define EV_SIM_TRACE_ZONE_END(var) ((void)0)
+
+#endif // EV_SIM_TRACE
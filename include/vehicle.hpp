@@ -0,0 +1,164 @@
+#pragma once
+
+#include "physics_core.hpp"
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * Vehicle body, wheels and road
+ *
+ * The defaults put ~8.4 kg⋅m² on the gearbox output, the gearbox's default
+ * output inertia.
+ */
+struct VehicleParameters {
+    float mass = 1430.0f;                 // Curb weight plus driver (kg)
+    float drag_area = 0.62f;              // Drag coefficient × frontal area, Cd⋅A (m²)
+    float rolling_resistance = 0.012f;    // Rolling resistance coefficient Crr
+    float wheel_radius = 0.31f;           // Loaded tire radius (m)
+    float wheel_inertia = 3.5f;           // All four wheels and brakes (kg⋅m²)
+    float final_drive = 4.1f;             // Gearbox output RPM / wheel RPM
+    float air_density = 1.225f;           // kg/m³
+    float grade = 0.0f;                   // Road slope, rise over run (0.05 = 5% uphill)
+};
+
+/**
+ * Per-vehicle coefficients of the longitudinal equation
+ *
+ * Derived once from the parameters (and again when the grade changes), so
+ * a step is the bare physics::vehicleSpeedStep arithmetic.
+ */
+struct VehicleCoefficients {
+    float radius;                  // Wheel radius (m)
+    float inv_radius;              // 1 / wheel radius (1/m)
+    float inv_mass;                // 1 / (mass + wheel inertia / r²) (1/kg)
+    float constant_force;          // Rolling resistance + grade (N)
+    float aero_coefficient;        // 0.5 * ρ * Cd⋅A (N/(m/s)²)
+    float inv_final_drive;         // Gearbox output torque per wheel torque
+    float output_rpm_per_speed;    // Gearbox output RPM per m/s
+    float speed_per_output_rpm;    // and back
+};
+
+VehicleCoefficients vehicleCoefficients(const VehicleParameters& params);
+
+/**
+ * Vehicle motion state; grade and the other parameters are not part of it
+ */
+struct VehicleState {
+    float speed;                   // m/s
+    float brake_torque;            // Nm at the wheels
+};
+
+/**
+ * Longitudinal dynamics of one vehicle: wheel torque in, road speed out
+ *
+ * Mass (plus the wheels' rotational inertia), aero drag, rolling
+ * resistance and grade, stepped with physics::vehicleSpeedStep. In gear
+ * the drivetrain carries the vehicle's inertia and road load through the
+ * gearbox and sets the speed from the output shaft; in neutral the vehicle
+ * coasts on its own. Brake torque counts as road load either way.
+ */
+class Vehicle {
+public:
+    explicit Vehicle(const VehicleParameters& params = VehicleParameters());
+
+    /**
+     * Advance the speed by one step
+     * @param wheel_torque Drive torque at the wheels, all driven wheels together (Nm)
+     * @param dt Time step (seconds)
+     */
+    void step(float wheel_torque, float dt);
+
+    /**
+     * Roll without drive for `duration`, in steps of dt (same result as stepping)
+     */
+    void coast(double duration, double dt);
+
+    /**
+     * Road load at the current speed plus the brakes, as torque at the wheels (Nm)
+     */
+    float getWheelLoadTorque() const {
+        return physics::roadLoadForce(speed_, coefficients_.constant_force, coefficients_.aero_coefficient) *
+               coefficients_.radius + brake_torque_;
+    }
+
+    float getSpeed() const { return speed_; }                // m/s
+    float getSpeedKmh() const { return speed_ * 3.6f; }
+    float getOutputRPM() const { return speed_ * coefficients_.output_rpm_per_speed; }
+    float getOutputInertia() const;                          // Vehicle seen at the gearbox output (kg⋅m²)
+    float getInverseFinalDrive() const { return coefficients_.inv_final_drive; }
+    const VehicleParameters& getParameters() const { return params_; }
+    const VehicleCoefficients& getCoefficients() const { return coefficients_; }
+
+    void setSpeed(float speed) { speed_ = speed; }
+    void setOutputRPM(float rpm) { speed_ = rpm * coefficients_.speed_per_output_rpm; }
+    void setGrade(float grade);
+
+    /**
+     * Service brakes, held until changed: opposes motion up to a standstill,
+     * never pushes backwards (Nm at the wheels, >= 0)
+     */
+    void setBrakeTorque(float torque) { brake_torque_ = torque > 0.0f ? torque : 0.0f; }
+    float getBrakeTorque() const { return brake_torque_; }
+
+    VehicleState snapshot() const { return { speed_, brake_torque_ }; }
+    void restore(const VehicleState& state) {
+        speed_ = state.speed;
+        brake_torque_ = state.brake_torque;
+    }
+
+private:
+    VehicleParameters params_;
+    VehicleCoefficients coefficients_;
+    float speed_;                  // m/s, forward only
+    float brake_torque_;           // Nm at the wheels
+};
+
+/**
+ * Structure-of-arrays fleet of vehicles stepped by one kernel
+ *
+ * Each coefficient lives in its own contiguous array, so step() streams
+ * through them with unit stride and the compiler vectorizes the loop;
+ * thousands of vehicles cost a few cycles each. Callers write wheel torques
+ * through wheelTorque() and read speeds back through speed().
+ *
+ * Road load only: there is no engine, clutch or gearbox per lane and no
+ * gear state, so it is not a batched Drivetrain. The runners step scalar
+ * Drivetrains; the benches use this kernel.
+ */
+class VehicleBatch {
+public:
+    /**
+     * Append a vehicle at rest
+     * @return Its index
+     */
+    int add(const VehicleParameters& params);
+
+    void clear();
+
+    /**
+     * Advance every vehicle by dt under its current wheel torque
+     */
+    void step(float dt);
+
+    void setGrade(int index, float grade);
+
+    int size() const { return static_cast<int>(speed_.size()); }
+
+    float* speed() { return speed_.data(); }                 // m/s
+    const float* speed() const { return speed_.data(); }
+    float* wheelTorque() { return wheel_torque_.data(); }    // Nm, held over each step
+    const float* wheelTorque() const { return wheel_torque_.data(); }
+
+private:
+    std::vector<VehicleParameters> params_;   // Cold: only read when coefficients change
+
+    std::vector<float> speed_;
+    std::vector<float> wheel_torque_;
+    std::vector<float> inv_radius_;
+    std::vector<float> inv_mass_;
+    std::vector<float> constant_force_;
+    std::vector<float> aero_coefficient_;
+};
+
+} // namespace ev_sim
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "driver_model.hpp"
+#include "drivetrain.hpp"
+#include "thread_pool.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ev_sim {
+
+/**
+ * One alternate continuation from a fork point
+ *
+ * The recorded inputs are reshaped per tick: the clutch pedal may rise
+ * (release) no faster than full travel in release_time, pressing stays
+ * immediate, and the throttle is scaled. configure() changes parameters on
+ * the variant's own drivetrain copy before the first step.
+ */
+struct WhatIfVariant {
+    std::string label;
+    float release_time = 0.0f;     // Slowest full clutch release (s); 0 = as recorded
+    float throttle_scale = 1.0f;   // Recorded throttle × this, clamped to 100 %
+    std::function<void(Drivetrain&)> configure;  // Parameter changes (may be empty)
+};
+
+/**
+ * What a continuation did, one value per tick after the fork
+ */
+struct WhatIfResult {
+    std::string label;
+    std::vector<float> engine_rpm;
+    std::vector<float> transmission_rpm;
+    std::vector<float> clutch_pedal_percent;  // Pedal actually applied
+    float max_slip_rpm = 0.0f;     // Largest |engine - transmission| RPM with the clutch (partly) engaged
+    int grind_ticks = 0;           // Ticks ending with the gearbox grinding
+    float final_speed_kmh = 0.0f;
+};
+
+/**
+ * Reshape recorded inputs the way a variant asks
+ * @param dt Tick length (s)
+ */
+std::vector<DriverCommand> applyVariant(const std::vector<DriverCommand>& inputs, const WhatIfVariant& variant,
+                                        float dt);
+
+/**
+ * Variants with evenly spaced clutch release times, fastest first
+ */
+std::vector<WhatIfVariant> releaseTimeSweep(int count, float shortest, float longest);
+
+/**
+ * Fork every variant from one state and run them in parallel
+ *
+ * Each job copies the base drivetrain, restores the fork state into the
+ * copy and steps it through the variant's inputs, requesting each tick's
+ * gear and brake as the dashboard does; nothing is shared for writing.
+ * The copy shares the base's torque and capacity maps (read-only
+ * shared_ptr), so a variant only pays for its own state and whatever
+ * configure() replaces. Thermal derating is held at the fork's value over
+ * the horizon.
+ *
+ * @param base Parameters and maps to fork from (its state is not used)
+ * @param fork State at the fork point
+ * @param inputs Recorded inputs for the ticks after the fork
+ * @param dt Tick length (s)
+ * @return One result per variant, in order
+ */
+std::vector<WhatIfResult> runWhatIf(const Drivetrain& base, const DrivetrainState& fork,
+                                    const std::vector<DriverCommand>& inputs,
+                                    const std::vector<WhatIfVariant>& variants, float dt, ThreadPool& pool);
+
+} // namespace ev_sim
@@ -1,12 +1,25 @@
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <cstdio>
 #include <cmath>
 #include <chrono>
 #include <thread>
 #include <vector>
-#include "include/engine.hpp"
-#include "include/clutch.hpp"
+#include "include/drivetrain.hpp"
+#include "include/battery.hpp"
+#include "include/motor.hpp"
+#include "include/multi_rate_scheduler.hpp"
+#include "include/rewind_buffer.hpp"
+#include "include/tick_monitor.hpp"
+#include "include/gauge_renderer.hpp"
+#include "include/frame_pacer.hpp"
+#include "include/plot_renderer.hpp"
+#include "include/profiler.hpp"
+#include "include/profiler_panel.hpp"
+#include "include/trace.hpp"
+#include "include/dashboard.hpp"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_opengl.h>
 #include <GL/gl.h>
@@ -14,87 +27,6 @@
 #include <imgui_impl_sdl3.h>
 #include <imgui_impl_opengl3.h>
 
-// MSVC may treat double->float as warning-as-error; use a float PI constant
-static constexpr float kPi = 3.14159265358979323846f;
-
-// Draw a half-circle RPM gauge
-void drawRPMGauge(const char* label, float value, float max_value, const ImVec4& color, float size = 120.0f) {
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-    ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
-    ImVec2 canvas_size = ImVec2(size, size * 0.6f);
-    
-    ImGui::InvisibleButton(label, canvas_size);
-    
-    ImVec2 center = ImVec2(canvas_pos.x + size * 0.5f, canvas_pos.y + size * 0.35f);
-    float radius = size * 0.4f;
-    
-    const int segments = 32;
-    const float start_angle = kPi;
-    const float end_angle = 0.0f;
-    
-    for (int i = 0; i < segments; i++) {
-        float a1 = start_angle + (end_angle - start_angle) * i / segments;
-        float a2 = start_angle + (end_angle - start_angle) * (i + 1) / segments;
-        
-        ImVec2 p1 = ImVec2(center.x + cosf(a1) * radius, center.y + sinf(a1) * radius);
-        ImVec2 p2 = ImVec2(center.x + cosf(a2) * radius, center.y + sinf(a2) * radius);
-        
-        draw_list->AddLine(p1, p2, IM_COL32(60, 60, 60, 255), 8.0f);
-    }
-    
-    float percentage = fminf(value / max_value, 1.0f);
-    float value_angle = start_angle + (end_angle - start_angle) * percentage;
-    
-    int value_segments = (int)(segments * percentage);
-    for (int i = 0; i < value_segments; i++) {
-        float a1 = start_angle + (end_angle - start_angle) * i / segments;
-        float a2 = start_angle + (end_angle - start_angle) * (i + 1) / segments;
-        
-        ImVec2 p1 = ImVec2(center.x + cosf(a1) * radius, center.y + sinf(a1) * radius);
-        ImVec2 p2 = ImVec2(center.x + cosf(a2) * radius, center.y + sinf(a2) * radius);
-        
-        ImU32 col = ImGui::ColorConvertFloat4ToU32(color);
-        draw_list->AddLine(p1, p2, col, 8.0f);
-    }
-    
-    ImVec2 needle_end = ImVec2(center.x + cosf(value_angle) * (radius - 10), 
-                               center.y + sinf(value_angle) * (radius - 10));
-    draw_list->AddLine(center, needle_end, IM_COL32(255, 255, 255, 255), 3.0f);
-    
-    draw_list->AddCircleFilled(center, 6.0f, IM_COL32(80, 80, 80, 255));
-    draw_list->AddCircleFilled(center, 4.0f, IM_COL32(200, 200, 200, 255));
-    
-    for (int i = 0; i <= 10; i++) {
-        float mark_angle = start_angle + (end_angle - start_angle) * i / 10.0f;
-        ImVec2 mark_inner = ImVec2(center.x + cosf(mark_angle) * (radius - 15), 
-                                   center.y + sinf(mark_angle) * (radius - 15));
-        ImVec2 mark_outer = ImVec2(center.x + cosf(mark_angle) * radius, 
-                                   center.y + sinf(mark_angle) * radius);
-        
-        float thickness = (i % 5 == 0) ? 2.0f : 1.0f;
-        draw_list->AddLine(mark_inner, mark_outer, IM_COL32(150, 150, 150, 255), thickness);
-    }
-    
-    ImVec2 text_size = ImGui::CalcTextSize("00000");
-    ImVec2 text_pos = ImVec2(center.x - text_size.x * 0.5f, center.y - 10);
-    
-    char value_text[32];
-    snprintf(value_text, sizeof(value_text), "%.0f", value);
-    draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), value_text);
-    
-    ImVec2 label_size = ImGui::CalcTextSize(label);
-    ImVec2 label_pos = ImVec2(center.x - label_size.x * 0.5f, center.y + 15);
-    draw_list->AddText(label_pos, IM_COL32(180, 180, 180, 255), label);
-    
-    char max_text[16];
-    snprintf(max_text, sizeof(max_text), "%.0f", max_value);
-    ImVec2 max_size = ImGui::CalcTextSize(max_text);
-    ImVec2 max_pos = ImVec2(center.x + radius - max_size.x, center.y + 5);
-    draw_list->AddText(max_pos, IM_COL32(120, 120, 120, 255), max_text);
-    
-    draw_list->AddText(ImVec2(center.x - radius, center.y + 5), IM_COL32(120, 120, 120, 255), "0");
-}
-
 // Helper function for clamping values
 inline float clamp(float value, float min_val, float max_val) {
     return std::max(min_val, std::min(value, max_val));
@@ -141,8 +73,11 @@ int main() {
         return 1;
     }
     
-    // Enable VSync
-    SDL_GL_SetSwapInterval(0);
+    // Frame pacing: VSync by default, switchable at runtime from the dashboard
+    ev_sim::FramePacer frame_pacer(ev_sim::PacingMode::VSync, 60.0f);
+    SDL_GL_SetSwapInterval(frame_pacer.getMode() == ev_sim::PacingMode::VSync ? 1 : 0);
+    int pacing_mode_index = static_cast<int>(frame_pacer.getMode());
+    float target_fps = frame_pacer.getTargetFps();
     
     // Initialize ImGui
     IMGUI_CHECKVERSION();
@@ -158,6 +93,11 @@ int main() {
     ImGui_ImplSDL3_InitForOpenGL(window, gl_context);
     ImGui_ImplOpenGL3_Init("#version 330");
     
+    // Dashboard gauges (static dial geometry is cached per size)
+    const float gauge_width = 120.0f; // Slightly smaller for better fit
+    ev_sim::GaugeRenderer engine_gauge("ENGINE", 7000.0f, ImVec4(1.0f, 0.3f, 0.3f, 1.0f), gauge_width);
+    ev_sim::GaugeRenderer trans_gauge("TRANSMISSION", 7000.0f, ImVec4(0.3f, 0.7f, 1.0f, 1.0f), gauge_width);
+    
     // Find and open the first available gamepad
     SDL_Gamepad* gamepad = nullptr;
     int num_joysticks = 0;
@@ -180,43 +120,176 @@ int main() {
     }
     
     
-    // Create engine and clutch
-    ev_sim::Engine engine(800.0f, 7000.0f, 0.1f, 200.0f, 0.25f);
-    ev_sim::Clutch clutch(10.0f);  // 10 Hz stiffness
+    // Create engine, clutch and transmission input shaft (starts from rest)
+    ev_sim::Drivetrain drivetrain(ev_sim::Engine(800.0f, 7000.0f, 0.1f, 200.0f, 0.25f),
+                                  ev_sim::Clutch(10.0f));  // 10 Hz stiffness
+    
+    // Electrical side: the engine's tractive shaft power through the motor map, drawn from the battery
+    ev_sim::TractionMotor motor;
+    ev_sim::Battery battery;
     
     // Simulation parameters
     const float dt = 0.1f;  // 100ms timestep for physics consistency
-    // Initialize transmission RPM (starts from rest)
-    float transmission_rpm = 0.0f;
     
-    // Timing variables
-    auto last_physics_time = std::chrono::steady_clock::now();
+    // Timing variables: physics ticks are scheduled on a fixed grid (seconds since start)
+    const auto clock_start = std::chrono::steady_clock::now();
+    auto seconds_since_start = [&](std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration<double>(t - clock_start).count();
+    };
+    ev_sim::TickScheduler physics_clock(dt);
+    ev_sim::TickMonitor tick_monitor;
+    physics_clock.reset(0.0);
     
     // Input variables
     float throttle_percent = 0.0f;
     float clutch_pedal_percent = 100.0f;  // Start with clutch fully pressed (disengaged)
     
-    // History for graphing (circular buffers)
+    // History for graphing (per-channel ring buffers, GPU-resident when available)
     const int history_size = 100;  // 10 seconds at 0.1s timestep
-    std::vector<float> engine_rpm_history(history_size, 800.0f);  // Initialize with idle RPM
-    std::vector<float> trans_rpm_history(history_size, 0.0f);
-    std::vector<float> throttle_history(history_size, 0.0f);  // Throttle input history
-    std::vector<float> clutch_pedal_history(history_size, 100.0f);  // Clutch pedal history (start disengaged)
-    std::vector<float> time_history(history_size, 0.0f);
-    int history_index = 0;
-    
+    ev_sim::PlotRenderer history_plot(history_size);
+    const ev_sim::HistoryChannels history_channels = ev_sim::addHistoryChannels(history_plot);
+    history_plot.initGL([](const char* name) {
+        return reinterpret_cast<ev_sim::PlotRenderer::GLProc>(SDL_GL_GetProcAddress(name));
+    });
+    
+    // Rewind ring: one state snapshot per physics tick in fixed memory
+    const int rewind_ticks = 600;  // 60 seconds at 0.1s timestep
+    ev_sim::RewindBuffer<ev_sim::SessionSnapshot> rewind(rewind_ticks);
+    ev_sim::RewindControls rewind_controls;
+    
+    // What-if fan-out from a rewind tick, one worker per hardware thread
+    ev_sim::ThreadPool what_if_pool;
+    ev_sim::WhatIfControls what_if_controls;
+    int what_if_shown = 0;  // Continuations overlaid on the history plots
+    
+    
+#if EV_SIM_PROFILER
+    // Frame/physics profiler (compiled out with EV_SIM_ENABLE_PROFILER=OFF)
+    ev_sim::FrameProfiler frame_profiler;
+    ev_sim::ProfilerPanel profiler_panel;
+#endif
+    
+#if EV_SIM_TRACE
+    // Scoped trace zones (recording is toggled from the Trace window)
+    ev_sim::TraceRecorder::instance().setThreadName("main");
+    ev_sim::TraceControls trace_controls;
+#endif
     
     bool running = true;
     float simulation_time = 0.0f;
     
+    // Subsystems at their own rates on the physics tick, in dependency order:
+    // drivetrain, electrical, then thermal (derating applies from the next tick), then history
+    const float thermal_period = 1.0f;
+    ev_sim::MultiRateScheduler physics_scheduler(dt);
+    physics_scheduler.addTask("Drivetrain", dt, [&](double) {
+        drivetrain.step(throttle_percent, clutch_pedal_percent, dt);
+    });
+    physics_scheduler.addTask("Electrical", dt, [&](double) {
+        // Engine braking is drag, not regeneration: the motor only sees tractive torque
+        battery.step(motor.update(std::max(drivetrain.getEngine().getTorque(), 0.0f), drivetrain.getEngineRPM()),
+                     dt);
+    });
+    physics_scheduler.addTask("Thermal", thermal_period, [&](double period) {
+        drivetrain.getEngine().updateThermal(static_cast<float>(period));
+    });
+    physics_scheduler.addTask("History", dt, [&](double) {
+        // Update history for graphing
+        history_plot.push(history_channels.engine_rpm, drivetrain.getEngineRPM());
+        history_plot.push(history_channels.trans_rpm, drivetrain.getTransmissionRPM());
+        history_plot.push(history_channels.throttle, throttle_percent);
+        history_plot.push(history_channels.clutch_pedal, clutch_pedal_percent);
+    });
+    
+    // Put a recorded tick back and redraw the history plots up to it
+    auto restoreSnapshot = [&](size_t back) {
+        const ev_sim::SessionSnapshot& snapshot = rewind.fromNewest(back);
+        drivetrain.restore(snapshot.drivetrain);
+        battery.restore(snapshot.battery);
+        simulation_time = snapshot.simulation_time;
+        physics_scheduler.setTicks(snapshot.scheduler_ticks);
+        
+        // Oldest first; pad with the oldest recorded tick when fewer than a plot's worth are kept
+        const size_t available = rewind.size() - back;
+        for (size_t i = history_size; i-- > 0;) {
+            const ev_sim::SessionSnapshot& sample = rewind.fromNewest(back + std::min(i, available - 1));
+            history_plot.push(history_channels.engine_rpm, sample.drivetrain.engine.rpm);
+            history_plot.push(history_channels.trans_rpm, sample.drivetrain.transmission_rpm);
+            history_plot.push(history_channels.throttle, sample.throttle_percent);
+            history_plot.push(history_channels.clutch_pedal, sample.clutch_pedal_percent);
+        }
+    };
+    
+    // Fork the what-if variants from a recorded tick, replaying the inputs recorded after it
+    auto forkWhatIf = [&](size_t back) {
+        const size_t horizon_ticks = std::clamp(static_cast<size_t>(what_if_controls.horizon / dt + 0.5f),
+                                                size_t(1), size_t(history_size));
+        // Past the newest tick the last recorded inputs hold
+        std::vector<ev_sim::DriverCommand> inputs(horizon_ticks);
+        for (size_t i = 0; i < horizon_ticks; i++) {
+            const ev_sim::SessionSnapshot& tick = rewind.fromNewest(back > i ? back - 1 - i : 0);
+            inputs[i].throttle_percent = tick.throttle_percent;
+            inputs[i].clutch_pedal_percent = tick.clutch_pedal_percent;
+            inputs[i].gear = tick.drivetrain.gearbox.requested_gear;
+            inputs[i].brake_torque = tick.drivetrain.vehicle.brake_torque;
+        }
+        std::vector<ev_sim::WhatIfVariant> variants = ev_sim::releaseTimeSweep(
+            what_if_controls.variants, what_if_controls.shortest_release, what_if_controls.longest_release);
+        for (ev_sim::WhatIfVariant& variant : variants) {
+            variant.throttle_scale = what_if_controls.throttle_scale;
+        }
+        
+        const ev_sim::SessionSnapshot& fork = rewind.fromNewest(back);
+        const auto start = std::chrono::steady_clock::now();
+        what_if_controls.results = ev_sim::runWhatIf(drivetrain, fork.drivetrain, inputs, variants, dt, what_if_pool);
+        what_if_controls.run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        what_if_controls.fork_time = fork.simulation_time;
+        what_if_shown = std::min(static_cast<int>(what_if_controls.results.size()), ev_sim::HistoryChannels::kMaxWhatIf);
+        
+        // Redraw the plots to end at the horizon: recorded ticks up to the fork, which
+        // every variant shares, then what was recorded after it against each variant
+        const size_t before = history_size - horizon_ticks;
+        for (size_t j = 0; j < static_cast<size_t>(history_size); j++) {
+            const size_t after = j - before;
+            const size_t tick_back = j < before ? std::min(back + (before - 1 - j), rewind.size() - 1)
+                                                : (back > after ? back - 1 - after : 0);
+            const ev_sim::SessionSnapshot& sample = rewind.fromNewest(tick_back);
+            history_plot.push(history_channels.engine_rpm, sample.drivetrain.engine.rpm);
+            history_plot.push(history_channels.trans_rpm, sample.drivetrain.transmission_rpm);
+            history_plot.push(history_channels.throttle, sample.throttle_percent);
+            history_plot.push(history_channels.clutch_pedal, sample.clutch_pedal_percent);
+            for (int v = 0; v < what_if_shown; v++) {
+                const ev_sim::WhatIfResult& result = what_if_controls.results[v];
+                history_plot.push(history_channels.what_if_engine_rpm[v],
+                                  j < before ? sample.drivetrain.engine.rpm : result.engine_rpm[after]);
+                history_plot.push(history_channels.what_if_trans_rpm[v],
+                                  j < before ? sample.drivetrain.transmission_rpm : result.transmission_rpm[after]);
+            }
+        }
+    };
+    
     // Main loop
     while (running) {
+        // Render-on-change mode: block until input arrives or the next physics step is due
+        if (frame_pacer.getMode() == ev_sim::PacingMode::OnDemand && !frame_pacer.hasPendingFrames()) {
+            const double until_physics = physics_clock.nextDue() - seconds_since_start(std::chrono::steady_clock::now());
+            if (until_physics > 0.0) {
+                SDL_WaitEventTimeout(nullptr, static_cast<Sint32>(std::ceil(until_physics * 1000.0)));
+            }
+        }
+        
+        frame_pacer.beginFrame();
+        EV_SIM_PROFILE_BEGIN_FRAME(frame_profiler);
+        EV_SIM_TRACE_ZONE_NAMED(frame_zone, "Frame", "frame");
         auto current_time = std::chrono::steady_clock::now();
+        bool state_changed = false;
         
         // Process SDL3 events
+        EV_SIM_TRACE_ZONE_NAMED(event_zone, "Event poll", "frame");
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             ImGui_ImplSDL3_ProcessEvent(&event);
+            state_changed = true;
             
             switch (event.type) {
                 case SDL_EVENT_QUIT:
@@ -227,6 +300,14 @@ int main() {
                     if (event.gbutton.button == SDL_GAMEPAD_BUTTON_START) {
                         running = false;
                     }
+                    // R1/L1 select the next gear up/down (0 = neutral)
+                    if (event.gbutton.button == SDL_GAMEPAD_BUTTON_RIGHT_SHOULDER) {
+                        ev_sim::Gearbox& gearbox = drivetrain.getGearbox();
+                        gearbox.requestGear(gearbox.getRequestedGear() + 1);
+                    } else if (event.gbutton.button == SDL_GAMEPAD_BUTTON_LEFT_SHOULDER) {
+                        ev_sim::Gearbox& gearbox = drivetrain.getGearbox();
+                        gearbox.requestGear(gearbox.getRequestedGear() - 1);
+                    }
                     break;
                     
                 case SDL_EVENT_GAMEPAD_ADDED:
@@ -248,6 +329,11 @@ int main() {
         }
         
         // Read controller input if available
+        EV_SIM_TRACE_ZONE_END(event_zone);
+        EV_SIM_PROFILE_MARK(frame_profiler, ev_sim::ProfilePhase::Input);
+        EV_SIM_TRACE_ZONE_NAMED(input_zone, "Input", "frame");
+        const float prev_throttle_percent = throttle_percent;
+        const float prev_clutch_pedal_percent = clutch_pedal_percent;
         if (gamepad) {
             // Right trigger (R2) for throttle
             int16_t right_trigger = SDL_GetGamepadAxis(gamepad, SDL_GAMEPAD_AXIS_RIGHT_TRIGGER);
@@ -261,80 +347,57 @@ int main() {
             throttle_percent = 0.0f;
             clutch_pedal_percent = 100.0f;  // Clutch disengaged
         }
+        if (throttle_percent != prev_throttle_percent || clutch_pedal_percent != prev_clutch_pedal_percent) {
+            state_changed = true;
+        }
         
         // Update physics at fixed timestep
-        auto physics_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - last_physics_time);
-        if (physics_elapsed.count() >= static_cast<long>(dt * 1000)) {
-            // Convert clutch pedal position to engagement level
-            // Clutch pedal: 100 = fully pressed (disengaged), 0 = released (engaged)
-            float clutch_engagement = 1.0f - (clutch_pedal_percent / 100.0f);
-            clutch_engagement = clamp(clutch_engagement, 0.0f, 1.0f);
-            
-            // Simulate drivetrain load (gradual application based on engagement)
-            float base_load = 15.0f;  // Base drivetrain losses
-            float speed_load = 0.01f * transmission_rpm;  // Speed-dependent load
-            
-            // Apply load gradually - use smooth engagement curve instead of hard threshold
-            float engagement_factor = std::max(0.0f, (clutch_engagement - 0.2f) / 0.8f); // Start at 20% engagement, full at 100%
-            engagement_factor = engagement_factor * engagement_factor; // Square for smoother curve
-            
-            // When clutch is engaged, there's actually LESS resistance due to transmission "support"
-            // The main effect should come from higher inertia, not higher load
-            float engine_rpm = engine.getRPM();
-            float rpm_ratio = engine_rpm / 7000.0f; // Normalize to max RPM
-            
-            // Aggressive engine braking when disengaged to make RPM fall quickly
-            float disengaged_extra_braking = (1.0f - clutch_engagement) * 20.0f * rpm_ratio; // Strong braking when disengaged
-            
-            // Minimal load when engaged, extra braking when disengaged
-            float base_resistance = engagement_factor * (base_load + speed_load) * 0.3f;
-            
-            float load_torque = base_resistance + disengaged_extra_braking;
-            
-            // Update engine with clutch engagement for variable inertia
-            engine.update(throttle_percent, load_torque, clutch_engagement, dt);
-            
-            // Get updated engine RPM after update
-            engine_rpm = engine.getRPM();
-            
-            // Update clutch (modifies RPMs by reference)
-            clutch.update(engine_rpm, transmission_rpm, clutch_engagement, dt);
-            
-            // Feed clutch-modified engine RPM back to engine object
-            // This ensures clutch synchronization affects the engine's internal state
-            if (clutch_engagement > 0.1f) { // Only when clutch is significantly engaged
-                engine.setRPM(engine_rpm);
-            }
-            
-            // Update history for graphing
-            engine_rpm_history[history_index] = engine_rpm;
-            trans_rpm_history[history_index] = transmission_rpm;
-            throttle_history[history_index] = throttle_percent;
-            clutch_pedal_history[history_index] = clutch_pedal_percent;
-            time_history[history_index] = simulation_time;
-            history_index = (history_index + 1) % history_size;
+        EV_SIM_TRACE_ZONE_END(input_zone);
+        EV_SIM_PROFILE_MARK(frame_profiler, ev_sim::ProfilePhase::Physics);
+        const double now_seconds = seconds_since_start(current_time);
+        // The clock keeps its schedule while paused; the ticks are just not run
+        const int due_steps = physics_clock.poll(now_seconds);
+        const int physics_steps = rewind_controls.paused ? 0 : due_steps;
+        tick_monitor.recordDropped(physics_clock.lastDropped());
+        for (int step = 0; step < physics_steps; step++) {
+            EV_SIM_PROFILE_PHYSICS_STEP(frame_profiler);
+            EV_SIM_TRACE_ZONE("Physics step", "frame");
+            tick_monitor.recordTick(physics_clock.scheduledTime(step), now_seconds, physics_steps);
+            
+            physics_scheduler.tick();
             
             simulation_time += dt;
-            last_physics_time = current_time;
+            rewind.push({ drivetrain.snapshot(), battery.snapshot(), simulation_time, physics_scheduler.ticks(),
+                          throttle_percent, clutch_pedal_percent });
+            state_changed = true;
+        }
+        
+        // Skip building an identical frame when nothing changed (render-on-change mode only)
+        if (!frame_pacer.shouldRender(state_changed)) {
+            EV_SIM_PROFILE_CANCEL_FRAME(frame_profiler);
+            continue;
         }
         
         // Console output removed - using ImGui dashboard for visualization
         
         // Start ImGui frame
+        EV_SIM_PROFILE_MARK(frame_profiler, ev_sim::ProfilePhase::ImGuiBuild);
+        EV_SIM_TRACE_ZONE_NAMED(build_zone, "ImGui build", "frame");
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL3_NewFrame();
         ImGui::NewFrame();
         
         // Get current values for dashboard
-        float engine_rpm = engine.getRPM();
+        float engine_rpm = drivetrain.getEngineRPM();
+        float transmission_rpm = drivetrain.getTransmissionRPM();
         float clutch_engagement = 1.0f - (clutch_pedal_percent / 100.0f);
         
         // Get engine torque for display
-        float engine_torque = engine.getTorque();
+        float engine_torque = drivetrain.getEngine().getTorque();
         
         // Create main dashboard window
         ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_FirstUseEver);
-        ImGui::SetNextWindowSize(ImVec2(600, 580), ImGuiCond_FirstUseEver); // Increased height for new UI elements
+        ImGui::SetNextWindowSize(ImVec2(600, 690), ImGuiCond_FirstUseEver); // Increased height for new UI elements
         
         if (ImGui::Begin("Manual EV Shift Simulator", nullptr, ImGuiWindowFlags_NoResize)) {
             
@@ -356,16 +419,15 @@ int main() {
                 ImGui::SetCursorPosY(5.0f); // Start gauges near the top
                 
                 // Calculate center positioning for gauges
-                float gauge_width = 120.0f; // Slightly smaller for better fit
                 float total_width = gauge_width * 2 + 50.0f; // Two gauges + spacing
                 float start_x = (ImGui::GetContentRegionAvail().x - total_width) * 0.5f;
                 
                 ImGui::SetCursorPosX(start_x);
-                drawRPMGauge("ENGINE", engine_rpm, 7000.0f, ImVec4(1.0f, 0.3f, 0.3f, 1.0f), gauge_width);
+                engine_gauge.draw(engine_rpm);
                 
                 ImGui::SameLine();
                 ImGui::SetCursorPosX(start_x + gauge_width + 50.0f);
-                drawRPMGauge("TRANSMISSION", transmission_rpm, 7000.0f, ImVec4(0.3f, 0.7f, 1.0f, 1.0f), gauge_width);
+                trans_gauge.draw(transmission_rpm);
             }
             ImGui::EndChild();
             
@@ -403,20 +465,64 @@ int main() {
             ImGui::PopStyleColor();
             ImGui::Spacing();
             
-            // Gear Position Display
-            ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.3f, 1.0f), "GEAR POSITION");
-            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
-            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
-            ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.3f, 0.3f, 0.3f, 1.0f));
-            ImGui::Button("1st", ImVec2(50, 30));
-            ImGui::PopStyleColor(3);
-            ImGui::SameLine(); ImGui::Text("First Gear");
+            // Gear Position Display: engaged gear lit, selected gear outlined, click to select
+            ev_sim::Gearbox& gearbox = drivetrain.getGearbox();
+            ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.3f, 1.0f), "GEAR POSITION (L1/R1)");
+            for (int gear = 0; gear <= gearbox.getGearCount(); gear++) {
+                char label[12] = "N";   // Room for any int, so -Wformat-truncation stays quiet
+                if (gear > 0) {
+                    std::snprintf(label, sizeof(label), "%d", gear);
+                }
+                const bool engaged = gear == gearbox.getGear() && gearbox.getState() != ev_sim::ShiftState::Synchronizing;
+                const bool selected = gear == gearbox.getRequestedGear();
+                ImGui::PushStyleColor(ImGuiCol_Button, engaged ? ImVec4(0.6f, 0.6f, 0.1f, 1.0f) : ImVec4(0.2f, 0.2f, 0.2f, 1.0f));
+                ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, selected ? 2.0f : 0.0f);
+                if (gear > 0) ImGui::SameLine();
+                if (ImGui::Button(label, ImVec2(34, 30))) {
+                    gearbox.requestGear(gear);
+                }
+                ImGui::PopStyleVar();
+                ImGui::PopStyleColor();
+            }
+            if (gearbox.isGrinding()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Grinding - press the clutch");
+            } else if (gearbox.isShiftBlocked()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Gear under load - press the clutch");
+            } else {
+                ImGui::Text("%s, output %.0f RPM", ev_sim::shiftStateName(gearbox.getState()), drivetrain.getOutputRPM());
+            }
+            ImGui::Spacing();
+            
+            // Vehicle speed and the road it is driving on
+            ev_sim::Vehicle& vehicle = drivetrain.getVehicle();
+            ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.8f, 1.0f), "VEHICLE SPEED");
+            ImGui::Text("%.1f km/h, road load %.0f Nm at the wheels", vehicle.getSpeedKmh(), vehicle.getWheelLoadTorque());
+            float grade_percent = vehicle.getParameters().grade * 100.0f;
+            if (ImGui::SliderFloat("Grade", &grade_percent, -10.0f, 15.0f, "%.1f%%")) {
+                vehicle.setGrade(grade_percent * 0.01f);
+            }
             ImGui::Spacing();
             
             // Engine Torque Display
             ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.4f, 1.0f), "ENGINE TORQUE");
             ImGui::Text("%.1f Nm", engine_torque);
             
+            // Engine temperature and thermal torque limit
+            const float torque_derate = drivetrain.getEngine().getTorqueDerate();
+            ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.4f, 1.0f), "ENGINE TEMPERATURE");
+            ImGui::Text("%.1f °C", drivetrain.getEngine().getTemperature());
+            if (torque_derate < 1.0f) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.2f, 1.0f), "derated to %.0f%%", torque_derate * 100.0f);
+            }
+            
+            // Battery state and the motor's operating efficiency
+            ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "BATTERY");
+            ImGui::Text("SOC %.2f%%, %.0f V, %.0f A (%.1f kW)", battery.getSOC() * 100.0f, battery.getVoltage(),
+                        battery.getCurrent(), battery.getPower() * 1e-3f);
+            ImGui::Text("Motor efficiency %.1f%%, used %.1f Wh", motor.getEfficiency() * 100.0f,
+                        (battery.getEnergy() + battery.getLossEnergy()) / 3600.0);
+            
             ImGui::NextColumn();
             
             // Right column - Status and controls
@@ -448,107 +554,94 @@ int main() {
         ImGui::End();
         
         // === RPM GRAPH WINDOW ===
-        ImGui::SetNextWindowPos(ImVec2(640, 20), ImGuiCond_FirstUseEver);
-        ImGui::SetNextWindowSize(ImVec2(600, 580), ImGuiCond_Always); // Force resize to match main dashboard window
+        ev_sim::drawHistoryWindow(history_plot, history_channels,
+                                  { engine_rpm, transmission_rpm, throttle_percent, clutch_pedal_percent, simulation_time },
+                                  what_if_shown);
         
-        if (ImGui::Begin("Engine & Transmission RPM Over Time", nullptr, ImGuiWindowFlags_NoResize)) {
-            
-            ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "RPM HISTORY - LAST 10 SECONDS");
-            ImGui::Separator();
-            ImGui::Spacing();
-            
-            // Create ordered arrays for plotting (ImGui expects chronological order)
-            std::vector<float> engine_plot_data(history_size);
-            std::vector<float> trans_plot_data(history_size);
-            std::vector<float> throttle_plot_data(history_size);
-            std::vector<float> clutch_plot_data(history_size);
-            
-            for (int i = 0; i < history_size; i++) {
-                int idx = (history_index + i) % history_size;
-                engine_plot_data[i] = engine_rpm_history[idx];
-                trans_plot_data[i] = trans_rpm_history[idx];
-                throttle_plot_data[i] = throttle_history[idx];
-                clutch_plot_data[i] = clutch_pedal_history[idx];
+        // === REWIND WINDOW ===
+        const ev_sim::RewindAction rewind_action = ev_sim::drawRewindWindow(rewind_controls, rewind, dt);
+        if (rewind_action != ev_sim::RewindAction::None) {
+            // Overlays belong to the old fork point
+            what_if_controls.results.clear();
+            what_if_shown = 0;
+        }
+        if (rewind_action == ev_sim::RewindAction::Seek) {
+            restoreSnapshot(rewind_controls.ticks_back);
+        } else if (rewind_action == ev_sim::RewindAction::Resume) {
+            // The ticks after the selection are a future that will not happen now
+            rewind.dropNewest(rewind_controls.ticks_back);
+            rewind_controls.ticks_back = 0;
+            restoreSnapshot(0);
+        }
+        
+        // === WHAT-IF WINDOW ===
+        const ev_sim::WhatIfAction what_if_action = ev_sim::drawWhatIfWindow(what_if_controls, rewind_controls, dt);
+        if (what_if_action == ev_sim::WhatIfAction::Run && rewind_controls.paused) {
+            forkWhatIf(rewind_controls.ticks_back);
+        } else if (what_if_action == ev_sim::WhatIfAction::Clear) {
+            what_if_controls.results.clear();
+            what_if_shown = 0;
+            if (rewind_controls.paused) {
+                restoreSnapshot(rewind_controls.ticks_back);  // Plots back to ending at the selection
             }
-            
-            // Plot Engine RPM
-            ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "ENGINE RPM");
-            ImGui::PlotLines("##EngineRPM", engine_plot_data.data(), history_size, 0, nullptr, 0.0f, 7000.0f, ImVec2(-1, 80));
-            
-            ImGui::Spacing();
-            
-            // Plot Transmission RPM  
-            ImGui::TextColored(ImVec4(0.3f, 0.7f, 1.0f, 1.0f), "TRANSMISSION RPM");
-            ImGui::PlotLines("##TransRPM", trans_plot_data.data(), history_size, 0, nullptr, 0.0f, 7000.0f, ImVec2(-1, 80));
-            
-            ImGui::Spacing();
-            ImGui::Separator();
-            ImGui::Spacing();
-            
-            // === INPUT HISTORY SECTION ===
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "THROTTLE & CLUTCH INPUT HISTORY");
-            ImGui::Spacing();
-            
-            // Combined throttle and clutch graph
-            if (ImGui::BeginChild("InputGraphChild", ImVec2(0, 100), true)) {
-                ImDrawList* draw_list = ImGui::GetWindowDrawList();
-                ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
-                ImVec2 canvas_size = ImGui::GetContentRegionAvail();
-                
-                // Draw background
-                draw_list->AddRectFilled(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y), 
-                                       IM_COL32(20, 20, 20, 255));
-                
-                // Draw grid lines (horizontal)
-                for (int i = 0; i <= 4; i++) {
-                    float y = canvas_pos.y + (canvas_size.y * i / 4.0f);
-                    draw_list->AddLine(ImVec2(canvas_pos.x, y), ImVec2(canvas_pos.x + canvas_size.x, y), 
-                                     IM_COL32(60, 60, 60, 255));
-                }
-                
-                // Draw throttle line (green)
-                for (int i = 0; i < history_size - 1; i++) {
-                    float x1 = canvas_pos.x + (canvas_size.x * i / (history_size - 1));
-                    float x2 = canvas_pos.x + (canvas_size.x * (i + 1) / (history_size - 1));
-                    float y1 = canvas_pos.y + canvas_size.y * (1.0f - throttle_plot_data[i] / 100.0f);
-                    float y2 = canvas_pos.y + canvas_size.y * (1.0f - throttle_plot_data[i + 1] / 100.0f);
-                    draw_list->AddLine(ImVec2(x1, y1), ImVec2(x2, y2), IM_COL32(0, 255, 100, 255), 2.0f);
-                }
+        }
+        
+        // === FRAME PACING WINDOW ===
+        ImGui::SetNextWindowPos(ImVec2(20, 720), ImGuiCond_FirstUseEver);
+        
+        if (ImGui::Begin("Frame Pacing", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+            for (int i = 0; i < static_cast<int>(ev_sim::PacingMode::Count); i++) {
+                if (i > 0) ImGui::SameLine();
+                ImGui::RadioButton(ev_sim::pacingModeName(static_cast<ev_sim::PacingMode>(i)), &pacing_mode_index, i);
+            }
+            ImGui::SliderFloat("Target FPS", &target_fps, 15.0f, 240.0f, "%.0f");
+            
+            if (ImGui::BeginTable("PacingStats", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Mode");
+                ImGui::TableSetupColumn("FPS");
+                ImGui::TableSetupColumn("Frame ms (avg)");
+                ImGui::TableSetupColumn("Frame ms (max)");
+                ImGui::TableSetupColumn("Work ms");
+                ImGui::TableSetupColumn("CPU %");
+                ImGui::TableHeadersRow();
                 
-                // Draw clutch line (orange)
-                for (int i = 0; i < history_size - 1; i++) {
-                    float x1 = canvas_pos.x + (canvas_size.x * i / (history_size - 1));
-                    float x2 = canvas_pos.x + (canvas_size.x * (i + 1) / (history_size - 1));
-                    float y1 = canvas_pos.y + canvas_size.y * (1.0f - clutch_plot_data[i] / 100.0f);
-                    float y2 = canvas_pos.y + canvas_size.y * (1.0f - clutch_plot_data[i + 1] / 100.0f);
-                    draw_list->AddLine(ImVec2(x1, y1), ImVec2(x2, y2), IM_COL32(255, 150, 0, 255), 2.0f);
+                for (int i = 0; i < static_cast<int>(ev_sim::PacingMode::Count); i++) {
+                    const ev_sim::PacingMode mode = static_cast<ev_sim::PacingMode>(i);
+                    const ev_sim::FrameStats& stats = frame_pacer.getStats(mode);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::Text("%s%s", ev_sim::pacingModeName(mode), mode == frame_pacer.getMode() ? " *" : "");
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.fps);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.frame_ms_avg);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.frame_ms_max);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", stats.work_ms_avg);
+                    ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.cpu_percent);
                 }
-                
-                // Draw scale labels
-                draw_list->AddText(ImVec2(canvas_pos.x + 5, canvas_pos.y + 2), IM_COL32(200, 200, 200, 255), "100%");
-                draw_list->AddText(ImVec2(canvas_pos.x + 5, canvas_pos.y + canvas_size.y - 15), IM_COL32(200, 200, 200, 255), "0%");
+                ImGui::EndTable();
             }
-            ImGui::EndChild();
-            
-            // Legend
-            ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.4f, 1.0f), "● THROTTLE");
-            ImGui::SameLine();
-            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "● CLUTCH PEDAL");
-            
-            ImGui::Spacing();
-            ImGui::Separator();
-            
-            // Current values
-            ImGui::Text("Current Engine RPM: %.0f", engine_rpm);
-            ImGui::Text("Current Transmission RPM: %.0f", transmission_rpm);
-            ImGui::Text("Current Throttle: %.1f%%", throttle_percent);
-            ImGui::Text("Current Clutch Pedal: %.1f%%", clutch_pedal_percent);
-            ImGui::Text("Time: %.1fs", simulation_time);
         }
         ImGui::End();
         
+        // === PHYSICS TIMING WINDOW ===
+        ev_sim::drawTickWindow(tick_monitor, dt);
+        
+#if EV_SIM_PROFILER
+        // === PROFILER WINDOW ===
+        profiler_panel.draw(frame_profiler);
+#endif
+        
+#if EV_SIM_TRACE
+        // === TRACE WINDOW ===
+        ev_sim::drawTraceWindow(trace_controls);
+#endif
+        
         // Rendering
         ImGui::Render();
+        EV_SIM_TRACE_ZONE_END(build_zone);
+        EV_SIM_PROFILE_MARK(frame_profiler, ev_sim::ProfilePhase::GLRender);
+        EV_SIM_TRACE_ZONE_NAMED(render_zone, "GL render", "frame");
+#if EV_SIM_PROFILER
+        profiler_panel.captureDrawData(ImGui::GetDrawData());
+#endif
         
         int display_w, display_h;
         SDL_GetWindowSizeInPixels(window, &display_w, &display_h);
@@ -557,13 +650,29 @@ int main() {
         glClear(GL_COLOR_BUFFER_BIT);
         
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        EV_SIM_TRACE_ZONE_END(render_zone);
+        EV_SIM_PROFILE_MARK(frame_profiler, ev_sim::ProfilePhase::Swap);
+        EV_SIM_TRACE_ZONE_NAMED(swap_zone, "Swap", "frame");
         SDL_GL_SwapWindow(window);
+        EV_SIM_TRACE_ZONE_END(swap_zone);
+        frame_pacer.endFrame();
+        EV_SIM_PROFILE_MARK(frame_profiler, ev_sim::ProfilePhase::Idle);
         
+        // Apply pacing changes made in the UI before pacing the next frame
+        if (pacing_mode_index != static_cast<int>(frame_pacer.getMode())) {
+            frame_pacer.setMode(static_cast<ev_sim::PacingMode>(pacing_mode_index));
+            SDL_GL_SetSwapInterval(frame_pacer.getMode() == ev_sim::PacingMode::VSync ? 1 : 0);
+        }
+        frame_pacer.setTargetFps(target_fps);
         
+        EV_SIM_TRACE_ZONE_NAMED(idle_zone, "Idle", "frame");
+        frame_pacer.waitForNextFrame();
+        EV_SIM_PROFILE_END_FRAME(frame_profiler);
     }
     
     
     // Cleanup ImGui
+    history_plot.shutdownGL();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL3_Shutdown();
     ImGui::DestroyContext();
@@ -0,0 +1,64 @@
+#include "adaptive_stepper.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+namespace {
+
+constexpr double kSafety = 0.9;      // Aim below the tolerance so most steps are accepted
+constexpr double kMaxGrowth = 5.0;
+constexpr double kMaxShrink = 0.2;
+
+} // namespace
+
+AdaptiveStepper::AdaptiveStepper(const AdaptiveStepOptions& options)
+    : options_(options)
+    , dt_(options.initial_dt)
+{
+    options_.min_dt = std::max(options_.min_dt, 1e-9);
+    options_.max_dt = std::max(options_.max_dt, options_.min_dt);
+    options_.tolerance_rpm = std::max(options_.tolerance_rpm, 1e-6f);
+    dt_ = std::clamp(dt_, options_.min_dt, options_.max_dt);
+}
+
+double AdaptiveStepper::step(Drivetrain& drivetrain, float throttle_percent, float clutch_pedal_percent,
+                             double max_step) {
+    EV_SIM_TRACE_ZONE("AdaptiveStepper::step", "physics");
+
+    for (;;) {
+        // A step cut short by max_step does not change the proposed size
+        const double dt = std::min(dt_, max_step);
+
+        Drivetrain full = drivetrain;
+        full.step(throttle_percent, clutch_pedal_percent, static_cast<float>(dt));
+
+        Drivetrain half = drivetrain;
+        half.step(throttle_percent, clutch_pedal_percent, static_cast<float>(0.5 * dt));
+        half.step(throttle_percent, clutch_pedal_percent, static_cast<float>(0.5 * dt));
+        counts_.evaluations += 3;
+
+        const double error = std::max(std::fabs(full.getEngineRPM() - half.getEngineRPM()),
+                                      std::fabs(full.getTransmissionRPM() - half.getTransmissionRPM()));
+        const double factor = error > 0.0
+            ? std::clamp(kSafety * std::sqrt(options_.tolerance_rpm / error), kMaxShrink, kMaxGrowth)
+            : kMaxGrowth;
+
+        if (error <= options_.tolerance_rpm || dt <= options_.min_dt) {
+            drivetrain = half;
+            counts_.accepted++;
+            counts_.min_dt = counts_.accepted == 1 ? dt : std::min(counts_.min_dt, dt);
+            counts_.max_dt = std::max(counts_.max_dt, dt);
+            if (dt == dt_ || factor < 1.0) {
+                dt_ = std::clamp(dt * factor, options_.min_dt, options_.max_dt);
+            }
+            return dt;
+        }
+
+        counts_.rejected++;
+        dt_ = std::clamp(dt * factor, options_.min_dt, options_.max_dt);
+    }
+}
+
+} // namespace ev_sim
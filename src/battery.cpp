@@ -0,0 +1,51 @@
+#include "battery.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+Battery::Battery(const BatteryParameters& params)
+    : params_(params)
+    , soc_(0.0)
+    , energy_(0.0)
+    , loss_energy_(0.0)
+    , voltage_(0.0f)
+    , current_(0.0f)
+    , resistance_(std::max(params.internal_resistance, 1e-6f))
+    , inv_four_resistance_(0.25f / resistance_)
+    , soc_per_coulomb_(1.0 / (std::max(params.capacity_ah, 1e-3f) * 3600.0))
+{
+    reset(params.initial_soc);
+}
+
+void Battery::reset(float soc) {
+    soc_ = std::clamp(static_cast<double>(soc), 0.0, 1.0);
+    energy_ = 0.0;
+    loss_energy_ = 0.0;
+    current_ = 0.0f;
+    voltage_ = getOpenCircuitVoltage();
+}
+
+float Battery::getOpenCircuitVoltage() const {
+    return params_.empty_voltage + (params_.full_voltage - params_.empty_voltage) * static_cast<float>(soc_);
+}
+
+float Battery::getLossPower() const {
+    return current_ * current_ * resistance_;
+}
+
+void Battery::step(float power_w, float dt) {
+    // SOC feeds the next step's voltage, so this is one dependency chain per
+    // step: divisions are precomputed, the sqrt and one divide remain
+    const float open_circuit = getOpenCircuitVoltage();
+    const float power = std::min(power_w, open_circuit * open_circuit * inv_four_resistance_);
+    const float discriminant = std::max(open_circuit * open_circuit - 4.0f * resistance_ * power, 0.0f);
+    current_ = 2.0f * power / (open_circuit + std::sqrt(discriminant));
+    voltage_ = open_circuit - resistance_ * current_;
+
+    soc_ = std::clamp(soc_ - static_cast<double>(current_ * dt) * soc_per_coulomb_, 0.0, 1.0);
+    energy_ += static_cast<double>(voltage_ * current_ * dt);
+    loss_energy_ += static_cast<double>(current_ * current_ * resistance_ * dt);
+}
+
+} // namespace ev_sim
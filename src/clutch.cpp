@@ -1,50 +1,130 @@
 #include "clutch.hpp"
+#include "trace.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace ev_sim {
 
+using physics::kRadPerSecToRPM;
+
+const char* clutchSolverName(ClutchSolver solver) {
+    switch (solver) {
+        case ClutchSolver::PerStep:  return "Per-step";
+        case ClutchSolver::Analytic: return "Analytic";
+        case ClutchSolver::Friction: return "Friction";
+        default:                     return "Unknown";
+    }
+}
+
 Clutch::Clutch(float stiffness)
     : stiffness_(stiffness)
+    , solver_(ClutchSolver::Analytic)
+    , kinetic_capacity_(250.0f)    // Holds the 200 Nm engine with margin
+    , static_ratio_(1.25f)
+    , driven_inertia_(0.05f)
     , engagement_level_(0.0f)
+    , locked_(false)
+    , transmitted_torque_(0.0f)
+    , slip_energy_(0.0f)
+    , event_time_(-1.0f)
 {
 }
 
+void Clutch::setFrictionParameters(float kinetic_capacity, float static_ratio, float driven_inertia) {
+    kinetic_capacity_ = std::max(kinetic_capacity, 0.0f);
+    static_ratio_ = std::max(static_ratio, 1.0f);
+    driven_inertia_ = std::max(driven_inertia, 1e-4f);
+}
+
 void Clutch::update(float& engine_rpm, float& transmission_rpm, 
-                    float clutch_engaged, float dt) {
+                    float clutch_engaged, float dt, float engine_share, bool coast) {
+    EV_SIM_TRACE_ZONE("Clutch::update", "physics");
+    
     // Clamp engagement level
     clutch_engaged = std::clamp(clutch_engaged, 0.0f, 1.0f);
     engagement_level_ = clutch_engaged;
+    locked_ = clutch_engaged == 1.0f;
+    transmitted_torque_ = 0.0f;
+    slip_energy_ = 0.0f;
+    event_time_ = -1.0f;
+    const bool analytic = solver_ != ClutchSolver::PerStep;
     
     if (clutch_engaged == 0.0f) {
-        // Disengaged: decay transmission RPM from internal friction
-        float decay_rate = 0.03f; // ~3% per second decay rate
-        transmission_rpm *= (1.0f - decay_rate * dt);
-        transmission_rpm = std::max(transmission_rpm, 0.0f); // prevent reversal
+        EV_SIM_TRACE_ZONE("Clutch::disengaged", "physics");
+        
+        // Disengaged: decay transmission RPM from internal friction (neutral only;
+        // in gear the caller applies the road load instead)
+        if (coast) {
+            transmission_rpm *= physics::coastFactor(dt, analytic);
+            transmission_rpm = std::max(transmission_rpm, 0.0f); // prevent reversal
+        }
         // Engine RPM remains unchanged (runs independently)
         return;
     }
-    else if (clutch_engaged == 1.0f) {
-        // Fully engaged: fast convergence toward average RPM
-        float avg_rpm = (engine_rpm + transmission_rpm) * 0.5f;
-        float fast_convergence_rate = 0.8f; // 80% convergence per timestep (much faster than partial engagement)
+    
+    // Fraction of the RPM gap to the average closed this step
+    float convergence_rate;
+    
+    if (clutch_engaged == 1.0f) {
+        EV_SIM_TRACE_ZONE("Clutch::locked", "physics");
         
-        // Move both RPMs toward their average quickly but not instantly
-        engine_rpm += (avg_rpm - engine_rpm) * fast_convergence_rate;
-        transmission_rpm += (avg_rpm - transmission_rpm) * fast_convergence_rate;
+        // Fully engaged: fast convergence toward average RPM (much faster than partial engagement)
+        convergence_rate = physics::clutchConvergence(1.0f, stiffness_, dt, analytic);
     }
     else {
-        // Partial engagement: gradual convergence by engagement, stiffness, dt
+        EV_SIM_TRACE_ZONE("Clutch::slipping", "physics");
         
-        float avg_rpm = (engine_rpm + transmission_rpm) * 0.5f;
-        float convergence_rate = clutch_engaged * stiffness_ * dt;
-        
-        // Clamp to prevent overshoot
-        convergence_rate = std::clamp(convergence_rate, 0.0f, 1.0f);
-        
-        // Move both RPMs toward average
-        engine_rpm += (avg_rpm - engine_rpm) * convergence_rate;
-        transmission_rpm += (avg_rpm - transmission_rpm) * convergence_rate;
+        // Partial engagement: gradual convergence by engagement, stiffness, dt
+        convergence_rate = physics::clutchConvergence(clutch_engaged, stiffness_, dt, analytic);
     }
+    
+    // Move both RPMs toward their (inertia-weighted) average
+    physics::clutchCouple(engine_rpm, transmission_rpm, convergence_rate, engine_share);
+}
+
+float Clutch::coastDown(float transmission_rpm, double duration, double dt) const {
+    double factor;
+    if (solver_ == ClutchSolver::Analytic || dt <= 0.0) {
+        factor = std::exp(-kCoastDecayRate * duration);
+    } else {
+        factor = std::pow(std::max(1.0 - kCoastDecayRate * dt, 0.0), duration / dt);
+    }
+    return std::max(static_cast<float>(transmission_rpm * factor), 0.0f);
+}
+
+void Clutch::updateFriction(float& engine_rpm, float& transmission_rpm,
+                            float engine_accel, float transmission_accel,
+                            float engine_inertia, float clutch_engaged, float dt,
+                            float reflected_inertia) {
+    EV_SIM_TRACE_ZONE("Clutch::updateFriction", "physics");
+    
+    clutch_engaged = std::clamp(clutch_engaged, 0.0f, 1.0f);
+    engagement_level_ = clutch_engaged;
+    
+    const float kinetic_torque = capacity_map_
+        ? capacity_map_->lookup(clutch_engaged, std::fabs(engine_rpm - transmission_rpm))
+        : clutch_engaged * kinetic_capacity_;
+    const float static_torque = static_ratio_ * kinetic_torque;
+    
+    const float engine_gain = kRadPerSecToRPM / std::max(engine_inertia, 1e-4f);
+    const float transmission_gain = kRadPerSecToRPM / (driven_inertia_ + std::max(reflected_inertia, 0.0f));
+    const physics::FrictionStep<float> step = physics::frictionStep(
+        engine_rpm, transmission_rpm, locked_, engine_accel, transmission_accel, engine_gain, transmission_gain,
+        kinetic_torque, static_torque, dt, kLockSlipRPM);
+    
+    transmitted_torque_ = dt > 0.0f ? step.impulse / dt : 0.0f;
+    slip_energy_ = step.heat;
+    event_time_ = step.event_time;
+}
+
+Table2D clutchCapacityMap(float kinetic_capacity) {
+    const TableAxis engagement_axis({ 0.0f, 0.1f, 0.2f, 0.3f, 0.45f, 0.6f, 0.8f, 1.0f });
+    const TableAxis slip_axis({ 0.0f, 100.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 4000.0f });
+    return tabulate(engagement_axis, slip_axis, [&](float engagement, float slip_rpm) {
+        // Fade saturates with slip speed and reaches 1 at the last breakpoint
+        const float fade = slip_rpm / (slip_rpm + 500.0f) * (4500.0f / 4000.0f);
+        return kinetic_capacity * engagement * std::sqrt(engagement) * (1.0f - 0.15f * fade);
+    });
 }
 
-} // namespace ev_sim
\ No newline at end of file
+} // namespace ev_sim
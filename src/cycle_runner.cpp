@@ -0,0 +1,141 @@
+#include "cycle_runner.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+using physics::kRadPerSecToRPM;
+
+CycleConfig::CycleConfig()
+    : name("default")
+    , engine(800.0f, 7000.0f, 0.1f, 200.0f, 0.25f)
+    , clutch(10.0f)
+{
+    clutch.setSolver(ClutchSolver::Friction);
+}
+
+CycleResult runCycle(const DriveCycle& cycle, const CycleConfig& config, const CycleOptions& options) {
+    EV_SIM_TRACE_ZONE("runCycle", "batch");
+
+    Drivetrain drivetrain(config.engine, config.clutch, Gearbox(config.gearbox), Vehicle(config.vehicle));
+    DriverModel driver(config.driver);
+    TractionMotor motor(config.motor);
+    Battery battery(config.battery);
+
+    CycleResult result;
+    result.cycle = cycle.name();
+    result.config = config.name;
+    result.duration = cycle.duration();
+    result.target_distance = cycle.distance();
+
+    const double dt = std::max(options.dt, 1e-4);
+    const float step_dt = static_cast<float>(dt);
+    const uint64_t steps = static_cast<uint64_t>(std::ceil(cycle.duration() / dt - 1e-9));
+    size_t cursor = 0;
+    double sum_sq_error = 0.0;
+    for (uint64_t i = 0; i < steps; i++) {
+        const double t_end = (i + 1) * dt;
+        const float target = cycle.speedAt(t_end, cursor);
+
+        const Vehicle& vehicle = drivetrain.getVehicle();
+        const float speed_start = vehicle.getSpeed();
+        driver.step(drivetrain, target, step_dt);
+        const float speed = vehicle.getSpeed();
+
+        // Work over the step, from the end-of-step torque and speeds
+        const float engine_torque = drivetrain.getEngine().getTorque();
+        const float engine_power = engine_torque * drivetrain.getEngineRPM() / kRadPerSecToRPM;
+        // Engine braking is drag, not regeneration: the motor only sees tractive torque
+        battery.step(motor.update(std::max(engine_torque, 0.0f), drivetrain.getEngineRPM()), step_dt);
+        result.engine_energy += std::max(engine_power, 0.0f) * dt;
+        result.brake_energy += vehicle.getBrakeTorque() * vehicle.getCoefficients().inv_radius *
+                               0.5 * (speed_start + speed) * dt;
+        result.slip_energy += drivetrain.getClutch().getSlipEnergy();
+        result.distance += 0.5 * (speed_start + speed) * dt;
+
+        const double error_kmh = (speed - target) * 3.6;
+        sum_sq_error += error_kmh * error_kmh;
+        result.max_speed_error = std::max(result.max_speed_error, std::fabs(error_kmh));
+    }
+    result.steps = steps;
+    result.battery_energy = battery.getEnergy() + battery.getLossEnergy();
+    result.final_soc = battery.getSOC();
+    result.shifts = driver.getShifts();
+    result.rms_speed_error = steps > 0 ? std::sqrt(sum_sq_error / steps) : 0.0;
+    return result;
+}
+
+AccelerationResult runAcceleration(const CycleConfig& config, const CycleOptions& options, float target_kmh,
+                                   double time_limit) {
+    EV_SIM_TRACE_ZONE("runAcceleration", "batch");
+
+    // Out of reach, so the PI throttle saturates
+    constexpr float kFlooredTarget = 100.0f;   // m/s
+
+    Drivetrain drivetrain(config.engine, config.clutch, Gearbox(config.gearbox), Vehicle(config.vehicle));
+    DriverModel driver(config.driver);
+    TractionMotor motor(config.motor);
+    Battery battery(config.battery);
+
+    AccelerationResult result;
+    const double dt = std::max(options.dt, 1e-4);
+    const float step_dt = static_cast<float>(dt);
+    const float target = target_kmh / 3.6f;
+    const uint64_t max_steps = static_cast<uint64_t>(std::ceil(time_limit / dt));
+    uint64_t step = 0;
+    for (; step < max_steps && drivetrain.getVehicle().getSpeed() < target; step++) {
+        driver.step(drivetrain, kFlooredTarget, step_dt);
+        battery.step(motor.update(std::max(drivetrain.getEngine().getTorque(), 0.0f), drivetrain.getEngineRPM()),
+                     step_dt);
+    }
+    result.reached = drivetrain.getVehicle().getSpeed() >= target;
+    result.time = step * dt;
+    result.battery_energy = battery.getEnergy() + battery.getLossEnergy();
+    result.shifts = driver.getShifts();
+    return result;
+}
+
+CoastDownResult runCoastDown(const CycleConfig& config, const CycleOptions& options, int gear, float start_kmh,
+                             double duration) {
+    Drivetrain drivetrain(config.engine, config.clutch, Gearbox(config.gearbox), Vehicle(config.vehicle));
+    const double dt = std::max(options.dt, 1e-4);
+    const float step_dt = static_cast<float>(dt);
+    drivetrain.getVehicle().setSpeed(start_kmh / 3.6f);
+    drivetrain.setOutputRPM(drivetrain.getVehicle().getOutputRPM());
+
+    // Clutch in while the synchronizer brings the input shaft to the gear
+    Gearbox& gearbox = drivetrain.getGearbox();
+    gearbox.requestGear(gear);
+    for (int i = 0; i < 1000 && (gearbox.getState() != ShiftState::InGear || gearbox.getGear() != gear); i++) {
+        drivetrain.step(0.0f, 100.0f, step_dt);
+    }
+
+    CoastDownResult result;
+    result.gear = gearbox.getGear();
+    const float start_speed = drivetrain.getVehicle().getSpeed();
+    Vehicle road(config.vehicle);
+    road.setSpeed(start_speed);
+    const uint64_t steps = static_cast<uint64_t>(std::ceil(duration / dt));
+    for (uint64_t i = 0; i < steps; i++) {
+        drivetrain.step(0.0f, 100.0f, step_dt);
+        road.step(0.0f, step_dt);
+    }
+    const double elapsed = steps * dt;
+    result.start_speed = start_speed * 3.6;
+    result.deceleration = (start_speed - drivetrain.getVehicle().getSpeed()) / elapsed;
+    result.road_deceleration = (start_speed - road.getSpeed()) / elapsed;
+    return result;
+}
+
+std::vector<CycleResult> runCycles(const std::vector<DriveCycle>& cycles, const std::vector<CycleConfig>& configs,
+                                   const CycleOptions& options, ThreadPool& pool) {
+    std::vector<CycleResult> results(cycles.size() * configs.size());
+    pool.parallelFor(results.size(), [&](size_t index) {
+        // Each job writes only its own slot
+        results[index] = runCycle(cycles[index / configs.size()], configs[index % configs.size()], options);
+    });
+    return results;
+}
+
+} // namespace ev_sim
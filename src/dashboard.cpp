@@ -0,0 +1,276 @@
+#include "dashboard.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace ev_sim {
+
+HistoryChannels addHistoryChannels(PlotRenderer& plot) {
+    const ImU32 rpm_plot_color = ImGui::GetColorU32(ImGuiCol_PlotLines);
+    HistoryChannels channels;
+    channels.engine_rpm = plot.addChannel(rpm_plot_color, 0.0f, 7000.0f, 800.0f, 1.0f);  // Initialize with idle RPM
+    channels.trans_rpm = plot.addChannel(rpm_plot_color, 0.0f, 7000.0f, 0.0f, 1.0f);
+    channels.throttle = plot.addChannel(IM_COL32(0, 255, 100, 255), 0.0f, 100.0f, 0.0f);  // Throttle input history
+    channels.clutch_pedal = plot.addChannel(IM_COL32(255, 150, 0, 255), 0.0f, 100.0f, 100.0f);  // Clutch pedal history (start disengaged)
+
+    // What-if continuations: thin lines shading from cyan (first variant) to magenta (last)
+    for (int i = 0; i < HistoryChannels::kMaxWhatIf; i++) {
+        const int shade = 255 * i / (HistoryChannels::kMaxWhatIf - 1);
+        const ImU32 color = IM_COL32(shade, 255 - shade, 255, 140);
+        channels.what_if_engine_rpm[i] = plot.addChannel(color, 0.0f, 7000.0f, 800.0f, 1.0f);
+        channels.what_if_trans_rpm[i] = plot.addChannel(color, 0.0f, 7000.0f, 0.0f, 1.0f);
+    }
+    return channels;
+}
+
+void drawHistoryWindow(PlotRenderer& plot, const HistoryChannels& channels, const DashboardReadout& readout,
+                       int what_if_shown) {
+    ImGui::SetNextWindowPos(ImVec2(640, 20), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(600, 580), ImGuiCond_Always); // Force resize to match main dashboard window
+
+    if (ImGui::Begin("Engine & Transmission RPM Over Time", nullptr, ImGuiWindowFlags_NoResize)) {
+
+        ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "RPM HISTORY - LAST 10 SECONDS");
+        if (what_if_shown > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("+ %d what-if continuations", what_if_shown);
+        }
+        ImGui::Separator();
+        ImGui::Spacing();
+
+        // What-if lines first so the recorded RPM stays on top
+        const int shown = std::clamp(what_if_shown, 0, HistoryChannels::kMaxWhatIf);
+        int rpm_channels[HistoryChannels::kMaxWhatIf + 1];
+
+        // Plot Engine RPM
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "ENGINE RPM");
+        std::copy(channels.what_if_engine_rpm, channels.what_if_engine_rpm + shown, rpm_channels);
+        rpm_channels[shown] = channels.engine_rpm;
+        plot.draw("##EngineRPM", ImVec2(-1, 80), rpm_channels, shown + 1, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+        ImGui::Spacing();
+
+        // Plot Transmission RPM
+        ImGui::TextColored(ImVec4(0.3f, 0.7f, 1.0f, 1.0f), "TRANSMISSION RPM");
+        std::copy(channels.what_if_trans_rpm, channels.what_if_trans_rpm + shown, rpm_channels);
+        rpm_channels[shown] = channels.trans_rpm;
+        plot.draw("##TransRPM", ImVec2(-1, 80), rpm_channels, shown + 1, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+        ImGui::Spacing();
+        ImGui::Separator();
+        ImGui::Spacing();
+
+        // === INPUT HISTORY SECTION ===
+        ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "THROTTLE & CLUTCH INPUT HISTORY");
+        ImGui::Spacing();
+
+        // Combined throttle and clutch graph
+        if (ImGui::BeginChild("InputGraphChild", ImVec2(0, 100), true)) {
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+            ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+
+            // Draw background
+            draw_list->AddRectFilled(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y), 
+                                   IM_COL32(20, 20, 20, 255));
+
+            // Draw grid lines (horizontal)
+            for (int i = 0; i <= 4; i++) {
+                float y = canvas_pos.y + (canvas_size.y * i / 4.0f);
+                draw_list->AddLine(ImVec2(canvas_pos.x, y), ImVec2(canvas_pos.x + canvas_size.x, y), 
+                                 IM_COL32(60, 60, 60, 255));
+            }
+
+            // Draw throttle (green) and clutch (orange) lines
+            const int input_channels[] = { channels.throttle, channels.clutch_pedal };
+            plot.drawInRect(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y),
+                                    input_channels, 2);
+
+            // Draw scale labels
+            draw_list->AddText(ImVec2(canvas_pos.x + 5, canvas_pos.y + 2), IM_COL32(200, 200, 200, 255), "100%");
+            draw_list->AddText(ImVec2(canvas_pos.x + 5, canvas_pos.y + canvas_size.y - 15), IM_COL32(200, 200, 200, 255), "0%");
+        }
+        ImGui::EndChild();
+
+        // Legend
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.4f, 1.0f), "● THROTTLE");
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "● CLUTCH PEDAL");
+
+        ImGui::Spacing();
+        ImGui::Separator();
+
+        // Current values
+        ImGui::Text("Current Engine RPM: %.0f", readout.engine_rpm);
+        ImGui::Text("Current Transmission RPM: %.0f", readout.transmission_rpm);
+        ImGui::Text("Current Throttle: %.1f%%", readout.throttle_percent);
+        ImGui::Text("Current Clutch Pedal: %.1f%%", readout.clutch_pedal_percent);
+        ImGui::Text("Time: %.1fs", readout.simulation_time);
+    }
+    ImGui::End();
+}
+
+RewindAction drawRewindWindow(RewindControls& controls, const RewindBuffer<SessionSnapshot>& ring, float period) {
+    ImGui::SetNextWindowPos(ImVec2(1260, 20), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(360, 150), ImGuiCond_FirstUseEver);
+
+    RewindAction action = RewindAction::None;
+    if (ImGui::Begin("Rewind")) {
+        ImGui::Text("%zu of %zu ticks (%.0f s), %.1f KB", ring.size(), ring.capacity(), ring.capacity() * period,
+                    ring.memoryBytes() / 1024.0);
+        if (!controls.paused) {
+            if (ImGui::Button("Pause", ImVec2(-1, 0)) && !ring.empty()) {
+                controls.paused = true;
+                controls.ticks_back = 0;
+            }
+        } else {
+            // Slider left = oldest, right = newest
+            const int last = static_cast<int>(ring.size()) - 1;
+            int position = last - controls.ticks_back;
+            if (ImGui::SliderInt("##RewindTick", &position, 0, last, "")) {
+                controls.ticks_back = last - std::clamp(position, 0, last);
+                action = RewindAction::Seek;
+            }
+            ImGui::Text("t = %.1f s (%.1f s back)", ring.fromNewest(controls.ticks_back).simulation_time,
+                        controls.ticks_back * period);
+            if (ImGui::Button("Drive from here", ImVec2(-1, 0))) {
+                controls.paused = false;
+                action = RewindAction::Resume;
+            }
+        }
+    }
+    ImGui::End();
+    return action;
+}
+
+WhatIfAction drawWhatIfWindow(WhatIfControls& controls, const RewindControls& rewind, float period) {
+    ImGui::SetNextWindowPos(ImVec2(1260, 190), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(360, 420), ImGuiCond_FirstUseEver);
+
+    WhatIfAction action = WhatIfAction::None;
+    if (ImGui::Begin("What-if")) {
+        ImGui::SliderInt("Variants", &controls.variants, 1, HistoryChannels::kMaxWhatIf);
+        ImGui::SliderFloat("Fastest release (s)", &controls.shortest_release, 0.0f, 3.0f, "%.2f");
+        ImGui::SliderFloat("Slowest release (s)", &controls.longest_release, 0.0f, 3.0f, "%.2f");
+        ImGui::SliderFloat("Throttle scale", &controls.throttle_scale, 0.0f, 2.0f, "%.2f");
+        ImGui::SliderFloat("Horizon (s)", &controls.horizon, period, 5.0f, "%.1f");
+
+        if (!rewind.paused) {
+            ImGui::TextDisabled("Pause in the Rewind window and pick the tick to fork from");
+        } else if (ImGui::Button("Run from the rewind selection", ImVec2(-1, 0))) {
+            action = WhatIfAction::Run;
+        }
+
+        if (!controls.results.empty()) {
+            if (ImGui::Button("Clear", ImVec2(-1, 0))) {
+                action = WhatIfAction::Clear;
+            }
+            ImGui::Text("%zu continuations from t = %.1f s in %.2f ms", controls.results.size(), controls.fork_time,
+                        controls.run_ms);
+            if (ImGui::BeginTable("##WhatIfResults", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Variant");
+                ImGui::TableSetupColumn("Max slip RPM");
+                ImGui::TableSetupColumn("Grind ticks");
+                ImGui::TableSetupColumn("End km/h");
+                ImGui::TableHeadersRow();
+                for (size_t i = 0; i < controls.results.size(); i++) {
+                    const WhatIfResult& result = controls.results[i];
+                    const int shade = 255 * static_cast<int>(i) / (HistoryChannels::kMaxWhatIf - 1);
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(IM_COL32(shade, 255 - shade, 255, 255)), "%s",
+                                       result.label.c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.0f", result.max_slip_rpm);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d", result.grind_ticks);
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f", result.final_speed_kmh);
+                }
+                ImGui::EndTable();
+            }
+        }
+    }
+    ImGui::End();
+    return action;
+}
+
+void drawTickWindow(const TickMonitor& monitor, float period) {
+    ImGui::SetNextWindowPos(ImVec2(960, 640), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(420, 330), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Physics Timing")) {
+        const TickStats stats = monitor.stats();
+        ImGui::Text("Ticks %llu @ %.0f ms | caught up %llu | dropped %llu",
+                    static_cast<unsigned long long>(stats.ticks), period * 1000.0f,
+                    static_cast<unsigned long long>(stats.caught_up), static_cast<unsigned long long>(stats.dropped));
+        ImGui::Text("Lateness ms: mean %.2f  jitter %.2f  p50 %.2f  p99 %.2f  max %.2f",
+                    stats.mean_ms, stats.jitter_ms, stats.p50_ms, stats.p99_ms, stats.max_ms);
+
+        // Lateness histogram over the whole run; the last bin is overflow
+        float bins[TickMonitor::kHistogramBins];
+        float bin_max = 1.0f;
+        for (int i = 0; i < TickMonitor::kHistogramBins; i++) {
+            bins[i] = static_cast<float>(monitor.histogram()[i]);
+            bin_max = std::max(bin_max, bins[i]);
+        }
+        char overlay[64];
+        std::snprintf(overlay, sizeof(overlay), "lateness, %.0f ms bins (last = overflow)", monitor.getBinMs());
+        ImGui::PlotHistogram("##TickHistogram", bins, TickMonitor::kHistogramBins, 0, overlay, 0.0f, bin_max,
+                             ImVec2(-1, 100));
+
+        // Lateness of recent ticks, oldest on the left
+        float recent[TickMonitor::kHistory];
+        const int count = monitor.count();
+        float recent_max = 1.0f;
+        for (int i = 0; i < count; i++) {
+            recent[i] = monitor.tick(i).lateness_ms;
+            recent_max = std::max(recent_max, recent[i]);
+        }
+        if (count > 0) {
+            ImGui::PlotLines("##TickLateness", recent, count, 0, "lateness per tick (ms)", 0.0f, recent_max,
+                             ImVec2(-1, 100));
+        }
+    }
+    ImGui::End();
+}
+
+#if EV_SIM_TRACE
+void drawTraceWindow(TraceControls& controls) {
+    ImGui::SetNextWindowPos(ImVec2(640, 640), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Trace", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+        TraceRecorder& recorder = TraceRecorder::instance();
+
+        bool recording = recorder.isEnabled();
+        if (ImGui::Checkbox("Record zones", &recording)) {
+            recorder.setEnabled(recording);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) {
+            recorder.clear();
+            controls.status.clear();
+        }
+
+        ImGui::SliderFloat("Window (s)", &controls.window_seconds, 0.5f, 30.0f, "%.1f");
+        if (ImGui::Button("Export Chrome trace")) {
+            const long zones = recorder.exportChromeTrace(controls.path, controls.window_seconds);
+            char status[256];
+            if (zones < 0) {
+                std::snprintf(status, sizeof(status), "Could not write %s", controls.path.c_str());
+            } else {
+                std::snprintf(status, sizeof(status), "Wrote %ld zones to %s", zones, controls.path.c_str());
+            }
+            controls.status = status;
+        }
+        if (!controls.status.empty()) {
+            ImGui::TextWrapped("%s", controls.status.c_str());
+        }
+        ImGui::TextDisabled("Open in chrome://tracing or ui.perfetto.dev");
+    }
+    ImGui::End();
+}
+#endif
+
+} // namespace ev_sim
@@ -0,0 +1,133 @@
+#include "drive_cycle.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace ev_sim {
+
+DriveCycle::DriveCycle()
+    : name_("cycle")
+{
+}
+
+bool DriveCycle::add(double time, float speed_kmh) {
+    if (!points_.empty() && time <= points_.back().time) {
+        return false;
+    }
+    CyclePoint point;
+    point.time = time;
+    point.speed = std::max(speed_kmh, 0.0f) / 3.6f;
+    points_.push_back(point);
+    return true;
+}
+
+bool DriveCycle::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+
+    points_.clear();
+    const size_t slash = path.find_last_of("/\\");
+    name_ = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        // Two comma-separated numbers; a non-numeric first row is the header
+        const char* cursor = line.c_str() + first;
+        char* end = nullptr;
+        const double time = std::strtod(cursor, &end);
+        if (end == cursor) {
+            if (points_.empty()) {
+                continue;
+            }
+            error = "line " + std::to_string(line_number) + ": expected time,speed_kmh";
+            return false;
+        }
+        cursor = end;
+        while (*cursor == ' ' || *cursor == '\t') cursor++;
+        const char* speed_start = *cursor == ',' ? cursor + 1 : cursor;
+        const double speed_kmh = std::strtod(speed_start, &end);
+        if (*cursor != ',' || end == speed_start) {
+            error = "line " + std::to_string(line_number) + ": expected time,speed_kmh";
+            return false;
+        }
+        if (!add(time, static_cast<float>(speed_kmh))) {
+            error = "line " + std::to_string(line_number) + ": time does not increase";
+            return false;
+        }
+    }
+
+    if (points_.empty()) {
+        error = "no points";
+        return false;
+    }
+    return true;
+}
+
+float DriveCycle::speedAt(double t) const {
+    size_t cursor = 0;
+    if (!points_.empty()) {
+        // Last point at or before t
+        auto it = std::upper_bound(points_.begin(), points_.end(), t,
+                                   [](double time, const CyclePoint& point) { return time < point.time; });
+        cursor = it == points_.begin() ? 0 : static_cast<size_t>(it - points_.begin()) - 1;
+    }
+    return speedAt(t, cursor);
+}
+
+float DriveCycle::speedAt(double t, size_t& cursor) const {
+    if (points_.empty()) {
+        return 0.0f;
+    }
+    if (cursor >= points_.size() || points_[cursor].time > t) {
+        cursor = 0;
+    }
+    while (cursor + 1 < points_.size() && points_[cursor + 1].time <= t) {
+        cursor++;
+    }
+    const CyclePoint& a = points_[cursor];
+    if (cursor + 1 == points_.size() || t <= a.time) {
+        return a.speed;
+    }
+    const CyclePoint& b = points_[cursor + 1];
+    const float w = static_cast<float>((t - a.time) / (b.time - a.time));
+    return a.speed + w * (b.speed - a.speed);
+}
+
+double DriveCycle::distance() const {
+    // Exact for the piecewise-linear speed: trapezoids
+    double distance = 0.0;
+    for (size_t i = 1; i < points_.size(); i++) {
+        distance += 0.5 * (points_[i - 1].speed + points_[i].speed) * (points_[i].time - points_[i - 1].time);
+    }
+    return distance;
+}
+
+DriveCycle urbanCycle(int repetitions) {
+    static const float kPoints[][2] = {
+        { 0, 0 }, { 11, 0 }, { 15, 15 }, { 23, 15 }, { 25, 10 }, { 28, 0 }, { 49, 0 }, { 61, 32 },
+        { 85, 32 }, { 96, 0 }, { 117, 0 }, { 143, 50 }, { 155, 50 }, { 163, 35 }, { 176, 35 },
+        { 188, 0 },
+    };
+    repetitions = std::max(repetitions, 1);
+    DriveCycle cycle;
+    cycle.setName(repetitions == 1 ? "urban (ECE-15)" : "urban (" + std::to_string(repetitions) + "x ECE-15)");
+    for (int repeat = 0; repeat < repetitions; repeat++) {
+        for (const auto& point : kPoints) {
+            cycle.add(repeat * 195.0 + point[0], point[1]);
+        }
+    }
+    cycle.add(repetitions * 195.0, 0.0f);
+    return cycle;
+}
+
+} // namespace ev_sim
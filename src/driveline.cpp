@@ -0,0 +1,102 @@
+#include "driveline.hpp"
+#include "physics_core.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+using physics::kRadPerSecToRPM;
+
+const char* shiftStateName(ShiftState state) {
+    switch (state) {
+        case ShiftState::Neutral:       return "Neutral";
+        case ShiftState::Synchronizing: return "Synchronizing";
+        case ShiftState::InGear:        return "In gear";
+        default:                        return "Unknown";
+    }
+}
+
+Gearbox::Gearbox(const GearboxParameters& params)
+    : params_(params)
+    , table_()
+    , state_(ShiftState::Neutral)
+    , gear_(0)
+    , requested_gear_(0)
+    , grinding_(false)
+    , blocked_(false)
+    , shift_time_(0.0f)
+{
+    params_.gear_count = std::clamp(params_.gear_count, 0, GearboxParameters::kMaxGears);
+    params_.output_inertia = std::max(params_.output_inertia, 1e-4f);
+
+    // Neutral and unused slots stay zero
+    for (int gear = 1; gear <= params_.gear_count; gear++) {
+        const float ratio = std::max(params_.ratios[gear - 1], 1e-3f);
+        table_.ratio[gear] = ratio;
+        table_.inv_ratio[gear] = 1.0f / ratio;
+        table_.reflected_inertia[gear] = params_.output_inertia / (ratio * ratio);
+    }
+}
+
+void Gearbox::requestGear(int gear) {
+    requested_gear_ = std::clamp(gear, 0, params_.gear_count);
+}
+
+void Gearbox::advanceShift(float& input_rpm, float& output_rpm, float clutch_engagement, float input_inertia, float dt) {
+    EV_SIM_TRACE_ZONE("Gearbox::updateShift", "physics");
+
+    const bool unloaded = clutch_engagement <= params_.shift_clutch_limit;
+    shift_time_ += dt;
+
+    if (state_ == ShiftState::InGear) {
+        if (!unloaded) {
+            // Dog teeth are held by the transmitted torque
+            blocked_ = true;
+            return;
+        }
+        state_ = ShiftState::Neutral;
+        gear_ = 0;
+    }
+
+    if (requested_gear_ == 0) {
+        state_ = ShiftState::Neutral;
+        shift_time_ = 0.0f;
+        return;
+    }
+
+    state_ = ShiftState::Synchronizing;
+    if (!unloaded) {
+        grinding_ = true;
+        return;
+    }
+
+    // The cone torque T speeds the input by T/J_in and, through the gear,
+    // slows the output; the mismatch closes at T * (1/J_in + 1/J_reflected)
+    const int target = requested_gear_;
+    const float ratio = table_.ratio[target];
+    const float reflected = table_.reflected_inertia[target];
+    const float inertia = std::max(input_inertia, 1e-4f);
+    const float mismatch = output_rpm * ratio - input_rpm;
+    const float closing_rate = params_.sync_torque * kRadPerSecToRPM * (1.0f / inertia + 1.0f / reflected);
+    if (std::fabs(mismatch) > params_.sync_tolerance_rpm && closing_rate > 0.0f) {
+        // Constant torque: the speed match time is exact
+        const float duration = std::min(dt, std::fabs(mismatch) / closing_rate);
+        const float impulse = (mismatch > 0.0f ? params_.sync_torque : -params_.sync_torque) * duration;
+        input_rpm += impulse * kRadPerSecToRPM / inertia;
+        output_rpm -= impulse * ratio * kRadPerSecToRPM / params_.output_inertia;
+        if (std::fabs(output_rpm * ratio - input_rpm) > params_.sync_tolerance_rpm) {
+            return;
+        }
+    }
+
+    // Dog engagement: the residual mismatch is absorbed, momentum conserved
+    const float common_rpm = (inertia * input_rpm + reflected * output_rpm * ratio) / (inertia + reflected);
+    input_rpm = std::max(common_rpm, 0.0f);
+    output_rpm = input_rpm * table_.inv_ratio[target];
+    state_ = ShiftState::InGear;
+    gear_ = target;
+    shift_time_ = 0.0f;
+}
+
+} // namespace ev_sim
@@ -0,0 +1,128 @@
+#include "driver_model.hpp"
+#include <cmath>
+
+namespace ev_sim {
+
+const char* driverPhaseName(DriverPhase phase) {
+    switch (phase) {
+        case DriverPhase::Stopped:  return "stopped";
+        case DriverPhase::Launch:   return "launch";
+        case DriverPhase::Shifting: return "shifting";
+        case DriverPhase::Driving:  return "driving";
+        default:                    return "unknown";
+    }
+}
+
+DriverModel::DriverModel(const DriverParameters& params)
+    : params_(params)
+{
+    reset();
+}
+
+void DriverModel::reset() {
+    phase_ = DriverPhase::Stopped;
+    phase_time_ = 0.0f;
+    since_shift_ = params_.shift_settle_time;
+    integral_ = 0.0f;
+    gear_ = 1;
+    shifts_ = 0;
+}
+
+void DriverModel::enter(DriverPhase phase) {
+    if (phase == phase_) {
+        return;
+    }
+    if (phase == DriverPhase::Shifting) {
+        shifts_++;
+        since_shift_ = 0.0f;
+    }
+    phase_ = phase;
+    phase_time_ = 0.0f;
+}
+
+DriverCommand DriverModel::update(const Drivetrain& drivetrain, float target, float dt) {
+    const Gearbox& gearbox = drivetrain.getGearbox();
+    const float speed = drivetrain.getVehicle().getSpeed();
+    const float error = target - speed;
+    const ShiftSchedule& schedule = params_.schedule;
+    phase_time_ += dt;
+    since_shift_ += dt;
+
+    // Stopping and starting
+    if (target < params_.stop_speed && speed < params_.stop_speed) {
+        enter(DriverPhase::Stopped);
+    } else if (phase_ == DriverPhase::Stopped && target >= params_.stop_speed) {
+        gear_ = 1;
+        enter(DriverPhase::Launch);
+    } else if (phase_ == DriverPhase::Driving && speed < params_.creep_speed && error < 0.0f) {
+        enter(DriverPhase::Stopped);    // Clutch in and roll to a stop on the brakes
+    }
+
+    // Shift decisions at the scheduled engine speeds, read on the input shaft: right
+    // after a release the engine can still be flaring on a slipping clutch
+    if (phase_ == DriverPhase::Driving && since_shift_ >= params_.shift_settle_time) {
+        const float rpm = drivetrain.getTransmissionRPM();
+        if (gear_ < gearbox.getGearCount() && rpm > schedule.upshift_rpm[gear_ - 1]) {
+            gear_++;
+            enter(DriverPhase::Shifting);
+        } else if (rpm < schedule.downshift_rpm && gear_ > 1) {
+            gear_--;
+            enter(DriverPhase::Shifting);
+        }
+    }
+
+    DriverCommand command;
+    command.gear = gear_;
+    if (error >= -params_.brake_deadband) {
+        // The pedal's real range is 0..100 %, which Drivetrain::step maps onto
+        // the engine's whole throttle. Anti-windup: hold the integral while
+        // the pedal is pinned at the end the error pushes toward
+        const float proportional = params_.throttle_gain * error;
+        const float demand = proportional + params_.throttle_integral_gain * integral_;
+        const bool saturated = (demand >= 100.0f && error > 0.0f) || (demand <= 0.0f && error < 0.0f);
+        if (phase_ == DriverPhase::Driving && std::fabs(error) < params_.integral_band && !saturated) {
+            integral_ += error * dt;
+        }
+        command.throttle_percent = std::clamp(proportional + params_.throttle_integral_gain * integral_, 0.0f, 100.0f);
+    } else {
+        integral_ = std::min(integral_, 0.0f);
+        command.brake_torque = std::min(params_.brake_gain * (-error - params_.brake_deadband),
+                                        params_.max_brake_torque);
+    }
+
+    float pedal = 0.0f;
+    switch (phase_) {
+        case DriverPhase::Stopped:
+            pedal = 100.0f;
+            command.throttle_percent = 0.0f;
+            integral_ = 0.0f;
+            command.brake_torque = std::max(command.brake_torque,
+                                            speed < params_.stop_speed ? params_.hold_brake_torque : 0.0f);
+            break;
+        case DriverPhase::Launch:
+            pedal = 100.0f * std::max(1.0f - phase_time_ / std::max(schedule.launch_time, 1e-3f), 0.0f);
+            if (pedal == 0.0f) {
+                enter(DriverPhase::Driving);
+            }
+            break;
+        case DriverPhase::Shifting:
+            // Clutch in and lift until the new gear is engaged, then release
+            if (gearbox.getState() != ShiftState::InGear || gearbox.getGear() != gear_) {
+                pedal = 100.0f;
+                command.throttle_percent = 0.0f;
+                phase_time_ = 0.0f;
+            } else {
+                pedal = 100.0f * std::max(1.0f - phase_time_ / std::max(schedule.release_time, 1e-3f), 0.0f);
+                if (pedal == 0.0f) {
+                    enter(DriverPhase::Driving);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    command.clutch_pedal_percent = pedal;
+    return command;
+}
+
+} // namespace ev_sim
@@ -0,0 +1,158 @@
+#include "drivetrain.hpp"
+#include "trace.hpp"
+#include <algorithm>
+
+namespace ev_sim {
+
+using physics::kRadPerSecToRPM;
+
+namespace {
+
+// The vehicle is what the gearbox output drives
+GearboxParameters drivingVehicle(GearboxParameters params, const Vehicle& vehicle) {
+    params.output_inertia = vehicle.getOutputInertia();
+    return params;
+}
+
+} // namespace
+
+Drivetrain::Drivetrain(const Engine& engine, const Clutch& clutch, const Gearbox& gearbox, const Vehicle& vehicle)
+    : engine_(engine)
+    , clutch_(clutch)
+    , gearbox_(drivingVehicle(gearbox.getParameters(), vehicle))
+    , vehicle_(vehicle)
+    , transmission_rpm_(0.0f)    // Starts from rest
+    , output_rpm_(0.0f)
+    , clutch_engagement_(0.0f)
+    , load_torque_(0.0f)
+    , road_torque_(0.0f)
+{
+    // Neutral: engine_inertia / (2 * engine_inertia) = 0.5, the original average
+    const float engine_inertia = engine_.getInertia();
+    for (int gear = 0; gear < GearTable::kSize; gear++) {
+        engine_share_[gear] = engine_inertia /
+                              (2.0f * engine_inertia + gearbox_.getTable().reflected_inertia[gear]);
+    }
+}
+
+void Drivetrain::step(float throttle_percent, float clutch_pedal_percent, float dt) {
+    EV_SIM_TRACE_ZONE("Drivetrain::step", "physics");
+
+    // Throttle pedal percent to the engine's [0, 1] throttle
+    const float throttle = std::clamp(throttle_percent * 0.01f, 0.0f, 1.0f);
+
+    // Convert clutch pedal position to engagement level
+    // Clutch pedal: 100 = fully pressed (disengaged), 0 = released (engaged)
+    float clutch_engagement = 1.0f - (clutch_pedal_percent / 100.0f);
+    clutch_engagement = std::clamp(clutch_engagement, 0.0f, 1.0f);
+    clutch_engagement_ = clutch_engagement;
+
+    // Simulate drivetrain load (gradual application based on engagement);
+    // the road load reaches the engine through the transmission instead
+    const float base_load = 15.0f;  // Base drivetrain losses
+
+    // Apply load gradually - use smooth engagement curve instead of hard threshold
+    float engagement_factor = std::max(0.0f, (clutch_engagement - 0.2f) / 0.8f); // Start at 20% engagement, full at 100%
+    engagement_factor = engagement_factor * engagement_factor; // Square for smoother curve
+
+    // When clutch is engaged, there's actually LESS resistance due to transmission "support"
+    // The main effect should come from higher inertia, not higher load
+    float engine_rpm = engine_.getRPM();
+    const float rpm_ratio = engine_rpm / engine_.getMaxRPM(); // Normalize to max RPM
+
+    // Aggressive engine braking when disengaged to make RPM fall quickly
+    const float disengaged_extra_braking = (1.0f - clutch_engagement) * 20.0f * rpm_ratio;
+
+    // Minimal load when engaged, extra braking when disengaged
+    const float base_resistance = engagement_factor * base_load * 0.3f;
+
+    load_torque_ = base_resistance + disengaged_extra_braking;
+
+    // Shifts first: the synchronizer works on the shafts before the clutch does
+    gearbox_.updateShift(transmission_rpm_, output_rpm_, clutch_engagement, clutch_.getDrivenInertia(), dt);
+    const int gear = gearbox_.getGear();
+    const GearTable& table = gearbox_.getTable();
+
+    // In gear the road load comes through the gear and final drive,
+    // decelerating the input shaft and everything geared to it
+    road_torque_ = 0.0f;
+    float road_accel = 0.0f;
+    if (gear > 0) {
+        vehicle_.setOutputRPM(output_rpm_);    // The dog engagement may have moved it
+        road_torque_ = vehicle_.getWheelLoadTorque() * vehicle_.getInverseFinalDrive() * table.inv_ratio[gear];
+        road_accel = -road_torque_ * kRadPerSecToRPM / (clutch_.getDrivenInertia() + table.reflected_inertia[gear]);
+    }
+
+    if (clutch_.getSolver() == ClutchSolver::Friction && dt > 0.0f) {
+        // Step the engine on its own to get its free acceleration, then let
+        // the clutch transmit torque between the two shafts over the step.
+        // Flywheel inertia only (engagement 0): the clutch adds the driven
+        // side's real inertia when it couples the shafts
+        const float engine_start_rpm = engine_rpm;
+        engine_.update(throttle, load_torque_, 0.0f, dt);
+        const float engine_accel = (engine_.getRPM() - engine_start_rpm) / dt;
+        // The neutral spin-down only acts on a free input shaft; in gear the road load carries it
+        const float coast_accel = gear == 0 ? -Clutch::kCoastDecayRate * transmission_rpm_ : 0.0f;
+        const float transmission_accel = coast_accel + road_accel;
+
+        clutch_.updateFriction(engine_rpm, transmission_rpm_, engine_accel, transmission_accel,
+                               engine_.getInertia(), clutch_engagement, dt,
+                               table.reflected_inertia[gear]);
+        engine_.setRPM(engine_rpm);
+    } else {
+        // Update engine with clutch engagement for variable inertia
+        engine_.update(throttle, load_torque_, clutch_engagement, dt);
+
+        // Update clutch (modifies RPMs by reference)
+        engine_rpm = engine_.getRPM();
+        clutch_.update(engine_rpm, transmission_rpm_, clutch_engagement, dt, engine_share_[gear], gear == 0);
+        if (gear > 0) {
+            transmission_rpm_ = std::max(transmission_rpm_ + road_accel * dt, 0.0f);
+        }
+
+        // Feed clutch-modified engine RPM back to the engine
+        if (clutch_engagement > 0.1f) { // Only when clutch is significantly engaged
+            engine_.setRPM(engine_rpm);
+        }
+    }
+
+    // Output shaft: geared to the input and carrying the vehicle, or turned
+    // by the vehicle coasting on its own in neutral
+    if (gear > 0) {
+        output_rpm_ = transmission_rpm_ * table.inv_ratio[gear];
+        vehicle_.setOutputRPM(output_rpm_);
+    } else if (output_rpm_ > 0.0f || vehicle_.getCoefficients().constant_force < 0.0f) {
+        // (At rest it stays at rest unless the grade pulls harder than rolling resistance)
+        vehicle_.setOutputRPM(output_rpm_);    // The synchronizer may have moved it
+        vehicle_.step(0.0f, dt);
+        output_rpm_ = vehicle_.getOutputRPM();
+    }
+}
+
+DrivetrainState Drivetrain::snapshot() const {
+    DrivetrainState state;
+    state.engine = engine_.snapshot();
+    state.clutch = clutch_.snapshot();
+    state.gearbox = gearbox_.snapshot();
+    state.vehicle = vehicle_.snapshot();
+    state.transmission_rpm = transmission_rpm_;
+    state.output_rpm = output_rpm_;
+    state.clutch_engagement = clutch_engagement_;
+    state.load_torque = load_torque_;
+    state.road_torque = road_torque_;
+    return state;
+}
+
+void Drivetrain::restore(const DrivetrainState& state) {
+    engine_.restore(state.engine);
+    clutch_.restore(state.clutch);
+    gearbox_.restore(state.gearbox);
+    vehicle_.restore(state.vehicle);
+    transmission_rpm_ = state.transmission_rpm;
+    output_rpm_ = state.output_rpm;
+    clutch_engagement_ = state.clutch_engagement;
+    load_torque_ = state.load_torque;
+    road_torque_ = state.road_torque;
+}
+
+} // namespace ev_sim
@@ -0,0 +1,48 @@
+#include "efficiency_map.hpp"
+#include "trace.hpp"
+#include <cassert>
+
+namespace ev_sim {
+
+namespace {
+
+constexpr int kFloatsPerLine = static_cast<int>(kCacheLineBytes / sizeof(float));
+
+} // namespace
+
+EfficiencyMap::EfficiencyMap()
+    : EfficiencyMap(1.0f, 1.0f, 2, 2, std::vector<float>(4, 1.0f))
+{
+}
+
+EfficiencyMap::EfficiencyMap(float max_rpm, float max_torque, int rpm_points, int torque_points,
+                             const std::vector<float>& values)
+    : rpm_points_(std::max(rpm_points, 2))
+    , torque_points_(std::max(torque_points, 2))
+    , stride_((torque_points_ + kFloatsPerLine - 1) / kFloatsPerLine * kFloatsPerLine)
+    , rpm_scale_((rpm_points_ - 1) / std::max(max_rpm, 1e-3f))
+    , torque_scale_((torque_points_ - 1) / std::max(max_torque, 1e-3f))
+    , last_row_(static_cast<float>(rpm_points_ - 1))
+    , last_column_(static_cast<float>(torque_points_ - 1))
+{
+    assert(static_cast<int>(values.size()) == rpm_points * torque_points);
+
+    // Padding repeats the last column, so it never reads as a real value
+    values_.assign(static_cast<size_t>(rpm_points_) * stride_, 0.0f);
+    for (int row = 0; row < rpm_points_; row++) {
+        for (int column = 0; column < stride_; column++) {
+            const int source = std::min(row, rpm_points - 1) * torque_points + std::min(column, torque_points - 1);
+            values_[row * stride_ + column] = source < static_cast<int>(values.size()) ? values[source] : 1.0f;
+        }
+    }
+}
+
+void EfficiencyMap::lookup(const float* rpm, const float* torque, float* efficiency, int count) const {
+    EV_SIM_TRACE_ZONE("EfficiencyMap::lookup", "physics");
+
+    for (int i = 0; i < count; i++) {
+        efficiency[i] = lookup(rpm[i], torque[i]);
+    }
+}
+
+} // namespace ev_sim
@@ -1,79 +1,56 @@
 #include "engine.hpp"
+#include "physics_core.hpp"
+#include "trace.hpp"
 #include <algorithm>
-#define _USE_MATH_DEFINES
 #include <cmath>
 
-// MSVC may not define M_PI with <cmath>; use our own constant for portability
-static constexpr float kPi = 3.14159265358979323846f;
-
 namespace ev_sim {
 
+using physics::kRadPerSecToRPM;
+using physics::kTorqueResponse;
+
+const char* engineIntegratorName(EngineIntegrator integrator) {
+    switch (integrator) {
+        case EngineIntegrator::ExplicitEuler:     return "Explicit Euler";
+        case EngineIntegrator::SemiImplicitEuler: return "Semi-implicit Euler";
+        case EngineIntegrator::RK4:               return "RK4";
+        default:                                  return "Unknown";
+    }
+}
+
 Engine::Engine(float idle_rpm, float max_rpm, float flywheel_inertia, float max_torque, float drag_coefficient)
     : rpm_(idle_rpm)
     , torque_output_(0.0f)
-    , temperature_(80.0f)  // Normal operating temperature
+    , thermal_()           // Starts at normal operating temperature
+    , torque_derate_(1.0f)
     , idle_rpm_(idle_rpm)
     , max_rpm_(max_rpm)
     , flywheel_inertia_(flywheel_inertia)
     , max_torque_(max_torque)
     , drag_coefficient_(drag_coefficient)
+    , integrator_(EngineIntegrator::SemiImplicitEuler)
 {
 }
 
 float Engine::calculateTorque(float throttle_percent) const {
-    // Simplified torque curve: rise to mid‑range peak, then fall toward redline
-    
-    const float rpm_ratio = rpm_ / max_rpm_;
-    float torque_curve;
-    
-    if (rpm_ratio < 0.6f) {
-        // Build up to peak torque - quadratic curve
-        torque_curve = (rpm_ratio / 0.6f) * (2.0f - rpm_ratio / 0.6f) * max_torque_;
-    } else if (rpm_ratio < 0.85f) {
-        // Maintain high torque in mid-range
-        torque_curve = max_torque_ * (1.0f - 0.1f * (rpm_ratio - 0.6f) / 0.25f);
-    } else {
-        // Gradual falloff toward redline
-        torque_curve = max_torque_ * 0.9f * (1.0f - rpm_ratio) / 0.15f;
-    }
-    
-    // Engine braking when throttle is low
-    const float min_throttle = 0.1f;
-    float engine_braking = 0.0f;
-    
-    if (throttle_percent < min_throttle) {
-        // Engine braking increases with RPM
-        engine_braking = -20.0f * rpm_ratio;  // Simple linear model
-    }
-    
-    // Calculate base torque
-    float base_torque = torque_curve * throttle_percent + engine_braking;
-    
-    // Rev limiter begins near redline
-    const float rev_limit_start = 0.98f * max_rpm_;
-    if (rpm_ >= rev_limit_start) {
-        // Linear reduction from rev_limit_start to max_rpm_
-        float limit_factor = (max_rpm_ - rpm_) / (max_rpm_ - rev_limit_start);
-        limit_factor = std::clamp(limit_factor, 0.0f, 1.0f);
-        base_torque *= limit_factor;
+    return torqueAt(rpm_, std::clamp(throttle_percent, 0.0f, 1.0f));
+}
+
+float Engine::torqueAt(float rpm, float throttle_percent) const {
+    // Thermal derating lowers the available torque, not engine braking
+    if (torque_map_) {
+        const float torque = torque_map_->lookup(rpm, throttle_percent);
+        return std::min(torque, torque * torque_derate_);
     }
-    
-    return base_torque;
+    return physics::engineTorque(rpm, throttle_percent, max_rpm_, max_torque_ * torque_derate_);
 }
 
 float Engine::calculateDragTorque() const {
-    // Quadratic drag: drag = -k * (rpm/1000)^2
-    const float rpm_thousands = rpm_ / 1000.0f;
-    return -drag_coefficient_ * rpm_thousands * rpm_thousands;
+    return physics::engineDrag(rpm_, drag_coefficient_);
 }
 
 float Engine::calculateEffectiveInertia(float clutch_engagement) const {
-    // Increase effective inertia with engagement (simulated driveline mass)
-    const float driveline_inertia_multiplier = 1.5f;
-    const float additional_inertia = flywheel_inertia_ * (driveline_inertia_multiplier - 1.0f);
-    
-    // Interpolate by engagement
-    return flywheel_inertia_ + (additional_inertia * clutch_engagement);
+    return physics::effectiveInertia(flywheel_inertia_, clutch_engagement);
 }
 
 float Engine::calculateRPMChange(float load_torque, float clutch_engagement, float dt) const {
@@ -90,45 +67,116 @@ float Engine::calculateRPMChange(float load_torque, float clutch_engagement, flo
     const float angular_accel = net_torque / effective_inertia;
     
     // Convert to RPM/s (rad/s² → RPM/s)
-    const float rpm_change = angular_accel * (60.0f / (2.0f * kPi)) * dt;
+    const float rpm_change = angular_accel * kRadPerSecToRPM * dt;
     
     return rpm_change;
 }
 
-void Engine::limitRPM() {
-    // Ensure RPM stays within valid range
-    if (rpm_ < idle_rpm_) {
-        // Apply additional torque to maintain idle
-        const float idle_error = idle_rpm_ - rpm_;
-        const float idle_correction = idle_error * 0.1f;  // Simple proportional control
-        rpm_ = std::max(rpm_ + idle_correction, 0.0f);
-    }
+Engine::StateRate Engine::stateRate(float torque, float rpm, float throttle_percent,
+                                    float load_torque, float clutch_engagement) const {
+    StateRate rate;
+    
+    // Output torque lags the torque curve
+    rate.torque = kTorqueResponse * (torqueAt(rpm, throttle_percent) - torque);
     
-    rpm_ = std::min(rpm_, max_rpm_);
+    // Net torque (output - load - quadratic drag) over effective inertia
+    const float net_torque = torque - load_torque + physics::engineDrag(rpm, drag_coefficient_);
+    rate.rpm = net_torque / calculateEffectiveInertia(clutch_engagement) * kRadPerSecToRPM;
+    
+    return rate;
+}
+
+void Engine::limitRPM(float dt) {
+    // Idle governor below idle, redline clamp above max
+    rpm_ = physics::limitRPM(rpm_, idle_rpm_, max_rpm_, dt);
 }
 
 void Engine::update(float throttle_percent, float load_torque, float clutch_engagement, float dt) {
+    EV_SIM_TRACE_ZONE("Engine::update", "physics");
+    
     // Clamp throttle input
     throttle_percent = std::clamp(throttle_percent, 0.0f, 1.0f);
     
     // Clamp clutch engagement
     clutch_engagement = std::clamp(clutch_engagement, 0.0f, 1.0f);
     
-    // Calculate target torque based on current state
-    float target_torque = calculateTorque(throttle_percent);
-    
-    // Apply exponential smoothing to torque changes
-    float smoothing_factor = std::clamp(5.0f * dt, 0.0f, 1.0f);
-    torque_output_ = torque_output_ + smoothing_factor * (target_torque - torque_output_);
-    
-    // Update RPM based on smoothed torque and variable inertia
-    rpm_ += calculateRPMChange(load_torque, clutch_engagement, dt);
+    switch (integrator_) {
+        case EngineIntegrator::ExplicitEuler: {
+            EV_SIM_TRACE_ZONE("Engine::integrate", "physics");
+            
+            // Both states from the start-of-step rates
+            const StateRate rate = stateRate(torque_output_, rpm_, throttle_percent, load_torque, clutch_engagement);
+            torque_output_ += rate.torque * dt;
+            rpm_ += rate.rpm * dt;
+            break;
+        }
+        
+        case EngineIntegrator::RK4: {
+            EV_SIM_TRACE_ZONE("Engine::integrate", "physics");
+            
+            const float torque = torque_output_;
+            const float rpm = rpm_;
+            const float half_dt = 0.5f * dt;
+            const StateRate k1 = stateRate(torque, rpm, throttle_percent, load_torque, clutch_engagement);
+            const StateRate k2 = stateRate(torque + half_dt * k1.torque, rpm + half_dt * k1.rpm,
+                                           throttle_percent, load_torque, clutch_engagement);
+            const StateRate k3 = stateRate(torque + half_dt * k2.torque, rpm + half_dt * k2.rpm,
+                                           throttle_percent, load_torque, clutch_engagement);
+            const StateRate k4 = stateRate(torque + dt * k3.torque, rpm + dt * k3.rpm,
+                                           throttle_percent, load_torque, clutch_engagement);
+            torque_output_ = torque + dt / 6.0f * (k1.torque + 2.0f * k2.torque + 2.0f * k3.torque + k4.torque);
+            rpm_ = rpm + dt / 6.0f * (k1.rpm + 2.0f * k2.rpm + 2.0f * k3.rpm + k4.rpm);
+            break;
+        }
+        
+        case EngineIntegrator::SemiImplicitEuler:
+        default: {
+            {
+                EV_SIM_TRACE_ZONE("Engine::torque", "physics");
+                
+                // Calculate target torque based on current state
+                float target_torque = calculateTorque(throttle_percent);
+                
+                // Apply exponential smoothing to torque changes
+                float smoothing_factor = std::clamp(kTorqueResponse * dt, 0.0f, 1.0f);
+                torque_output_ = torque_output_ + smoothing_factor * (target_torque - torque_output_);
+            }
+            
+            EV_SIM_TRACE_ZONE("Engine::integrate", "physics");
+            
+            // Update RPM based on smoothed torque and variable inertia
+            rpm_ += calculateRPMChange(load_torque, clutch_engagement, dt);
+            break;
+        }
+    }
     
     // Apply RPM limits
-    limitRPM();
+    limitRPM(dt);
     
-    // Simple temperature model (future enhancement)
-    // temperature_ = ...
+    // Shaft power heats the engine; the temperature itself moves in updateThermal()
+    thermal_.addHeat(torque_output_ * rpm_ / kRadPerSecToRPM, dt);
+}
+
+void Engine::updateThermal(float dt) {
+    thermal_.update(dt);
+    torque_derate_ = thermal_.getTorqueDerate();
+}
+
+Table2D engineTorqueMap(const Engine& engine) {
+    const float max_rpm = engine.getMaxRPM();
+    std::vector<float> rpm_points;
+    for (int i = 0; i <= 8; i++) {
+        rpm_points.push_back(0.6f * max_rpm * i / 8);
+    }
+    for (float ratio : { 0.85f, 0.98f, 0.99f, 1.0f }) {
+        rpm_points.push_back(ratio * max_rpm);
+    }
+    const std::vector<float> throttle_points = { 0.0f, std::nextafter(0.1f, 0.0f), 0.1f, 1.0f };
+
+    const float max_torque = engine.getMaxTorque();
+    return tabulate(TableAxis(rpm_points), TableAxis(throttle_points), [&](float rpm, float throttle) {
+        return physics::engineTorque(rpm, throttle, max_rpm, max_torque);
+    });
 }
 
-} // namespace ev_sim 
\ No newline at end of file
+} // namespace ev_sim
@@ -0,0 +1,107 @@
+#include "fast_forward.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+SteadyStateDetector::SteadyStateDetector(const FastForwardOptions& options)
+    : options_(options)
+    , observed_(0)
+    , engine_rpm_(0.0f)
+    , engine_torque_(0.0f)
+    , transmission_rpm_(0.0f)
+    , dt_(0.0)
+    , residual_(0.0f)
+    , ratio_(-1.0f)
+    , bound_(0.0f)
+{
+}
+
+void SteadyStateDetector::reset() {
+    observed_ = 0;
+}
+
+bool SteadyStateDetector::observe(const Drivetrain& drivetrain, double dt) {
+    if (!options_.enabled) {
+        return false;
+    }
+    if (drivetrain.getGearbox().getState() == ShiftState::Synchronizing) {
+        // The synchronizer moves the shafts at a constant rate, not geometrically
+        observed_ = 0;
+        return false;
+    }
+
+    // A disengaged transmission in neutral is handled in closed form, so
+    // only the engine must settle; in gear it carries the vehicle and must
+    // settle as well
+    const bool decoupled = drivetrain.getClutchEngagement() == 0.0f && drivetrain.getGearbox().getGear() == 0;
+    const float engine_rpm = drivetrain.getEngineRPM();
+    const float engine_torque = drivetrain.getEngine().getTorque();
+    const float transmission_rpm = drivetrain.getTransmissionRPM();
+
+    float residual = 0.0f;
+    bool torque_settled = false;
+    if (observed_ > 0) {
+        torque_settled = std::fabs(engine_torque - engine_torque_) <= options_.torque_settled_nm;
+        residual = std::fabs(engine_rpm - engine_rpm_);
+        if (!decoupled) {
+            residual = std::max(residual, std::fabs(transmission_rpm - transmission_rpm_));
+        }
+    }
+
+    bool steady = false;
+    float ratio = -1.0f;
+    if (observed_ >= 2) {
+        if (residual == 0.0f && residual_ == 0.0f) {
+            // Exact fixed point of the step map
+            bound_ = 0.0f;
+            steady = torque_settled;
+        } else if (residual_ > 0.0f) {
+            // Contraction per step of this size. With a varying step (adaptive mode) the
+            // residuals are compared as rates (RPM/s), whose ratio spans the time between
+            // the two step midpoints, and the previous ratio is rescaled to this step size
+            float previous = ratio_;
+            if (dt == dt_) {
+                ratio = residual / residual_;
+            } else {
+                const double rate_ratio = (residual / dt) / (residual_ / dt_);
+                ratio = static_cast<float>(std::pow(rate_ratio, dt / (0.5 * (dt + dt_))));
+                if (ratio_ >= 0.0f) {
+                    previous = static_cast<float>(std::pow(static_cast<double>(ratio_), dt / dt_));
+                }
+            }
+            const bool converged = ratio_ >= 0.0f && std::fabs(ratio - previous) <= options_.ratio_settled;
+            if (converged && ratio <= options_.max_contraction) {
+                bound_ = residual * ratio / (1.0f - ratio);
+                steady = torque_settled && bound_ <= options_.tolerance_rpm;
+            }
+        }
+    }
+
+    engine_rpm_ = engine_rpm;
+    engine_torque_ = engine_torque;
+    transmission_rpm_ = transmission_rpm;
+    dt_ = dt;
+    residual_ = residual;
+    ratio_ = ratio;
+    observed_++;
+    return steady;
+}
+
+void SteadyStateDetector::fastForward(Drivetrain& drivetrain, double duration, double dt) {
+    // The output shaft follows the input in gear; in neutral the vehicle
+    // coasts on its own, replayed with its (cheap) step at the skipped dt
+    const Gearbox& gearbox = drivetrain.getGearbox();
+    if (gearbox.getGear() > 0) {
+        drivetrain.setOutputRPM(drivetrain.getTransmissionRPM() * gearbox.getInverseRatio());
+        return;
+    }
+    if (drivetrain.getClutchEngagement() == 0.0f) {
+        drivetrain.setTransmissionRPM(drivetrain.getClutch().coastDown(drivetrain.getTransmissionRPM(), duration, dt));
+    }
+    Vehicle& vehicle = drivetrain.getVehicle();
+    vehicle.coast(duration, dt);
+    drivetrain.setOutputRPM(vehicle.getOutputRPM());
+}
+
+} // namespace ev_sim
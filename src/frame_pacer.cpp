@@ -0,0 +1,224 @@
+#include "frame_pacer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace ev_sim {
+
+namespace {
+
+// Stats are refreshed twice per second
+constexpr double kStatsWindowSeconds = 0.5;
+
+// Frames rendered after a change in OnDemand mode (ImGui needs a couple to settle hover/animations)
+constexpr int kSettleFrames = 3;
+
+// Cap on the sleep estimator sample count so it keeps adapting to timer changes
+constexpr int64_t kMaxSleepSamples = 1000;
+
+double toSeconds(FramePacer::Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+} // namespace
+
+const char* pacingModeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSync:     return "VSync";
+        case PacingMode::CappedFps: return "Capped FPS";
+        case PacingMode::OnDemand:  return "Render on change";
+        default:                    return "Unknown";
+    }
+}
+
+double processCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+        return 0.0;
+    }
+    // FILETIME is in 100 ns units
+    auto to_ticks = [](const FILETIME& ft) {
+        return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    return static_cast<double>(to_ticks(kernel_time) + to_ticks(user_time)) * 1e-7;
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+#endif
+}
+
+FramePacer::FramePacer(PacingMode mode, float target_fps)
+    : mode_(mode)
+    , target_fps_(0.0f)
+    , frame_period_(Clock::duration::zero())
+    , has_presented_(false)
+    , pending_frames_(kSettleFrames)
+    , sleep_estimate_(5e-3)
+    , sleep_mean_(5e-3)
+    , sleep_var_(0.0)
+    , sleep_samples_(1)
+    , window_cpu_start_(0.0)
+    , window_frames_(0)
+    , window_frame_sum_(0.0)
+    , window_frame_max_(0.0)
+    , window_work_sum_(0.0)
+{
+    setTargetFps(target_fps);
+    const Clock::time_point now = Clock::now();
+    frame_begin_ = now;
+    last_present_ = now;
+    next_deadline_ = now;
+    resetWindow(now);
+}
+
+void FramePacer::setMode(PacingMode mode) {
+    if (mode == mode_) {
+        return;
+    }
+    mode_ = mode;
+
+    // Don't attribute the switch-over gap to the new mode
+    const Clock::time_point now = Clock::now();
+    has_presented_ = false;
+    next_deadline_ = now;
+    pending_frames_ = kSettleFrames;
+    resetWindow(now);
+}
+
+void FramePacer::setTargetFps(float target_fps) {
+    target_fps_ = std::clamp(target_fps, 1.0f, 1000.0f);
+    frame_period_ = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / target_fps_));
+}
+
+void FramePacer::beginFrame() {
+    frame_begin_ = Clock::now();
+    updateStats(frame_begin_);
+}
+
+bool FramePacer::shouldRender(bool state_changed) {
+    if (mode_ != PacingMode::OnDemand) {
+        return true;
+    }
+
+    if (state_changed) {
+        requestFrames(kSettleFrames);
+    }
+    if (pending_frames_ > 0) {
+        pending_frames_--;
+        return true;
+    }
+    return false;
+}
+
+void FramePacer::requestFrames(int frames) {
+    pending_frames_ = std::max(pending_frames_, frames);
+}
+
+void FramePacer::endFrame() {
+    const Clock::time_point now = Clock::now();
+
+    if (has_presented_) {
+        const double frame_time = toSeconds(now - last_present_);
+        window_frame_sum_ += frame_time;
+        window_frame_max_ = std::max(window_frame_max_, frame_time);
+        window_work_sum_ += toSeconds(now - frame_begin_);
+        window_frames_++;
+    }
+    stats_[static_cast<int>(mode_)].frames++;
+
+    last_present_ = now;
+    has_presented_ = true;
+
+    // Schedule the next frame; after a stall, resync instead of bursting to catch up
+    next_deadline_ += frame_period_;
+    if (next_deadline_ < now) {
+        next_deadline_ = now;
+    }
+
+    updateStats(now);
+}
+
+void FramePacer::waitForNextFrame() {
+    if (mode_ == PacingMode::VSync) {
+        return;
+    }
+    // OnDemand idles by blocking on events; only pace iterations that presented
+    if (mode_ == PacingMode::OnDemand && last_present_ < frame_begin_) {
+        return;
+    }
+    preciseWaitUntil(next_deadline_);
+}
+
+void FramePacer::preciseWaitUntil(Clock::time_point deadline) {
+    // Sleep in 1 ms slices while there is more time left than a slice tends to take
+    for (;;) {
+        const Clock::time_point start = Clock::now();
+        if (toSeconds(deadline - start) <= sleep_estimate_) {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const double observed = toSeconds(Clock::now() - start);
+
+        // Running mean/variance of the observed slice length (exponential once the sample cap is hit)
+        sleep_samples_ = std::min(sleep_samples_ + 1, kMaxSleepSamples);
+        const double alpha = 1.0 / static_cast<double>(sleep_samples_);
+        const double delta = observed - sleep_mean_;
+        sleep_mean_ += alpha * delta;
+        sleep_var_ = (1.0 - alpha) * (sleep_var_ + alpha * delta * delta);
+        sleep_estimate_ = sleep_mean_ + std::sqrt(sleep_var_);
+    }
+
+    // Spin for the remainder
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::updateStats(Clock::time_point now) {
+    const double elapsed = toSeconds(now - window_start_);
+    if (elapsed < kStatsWindowSeconds) {
+        return;
+    }
+
+    FrameStats& stats = stats_[static_cast<int>(mode_)];
+    const double cpu = processCpuSeconds() - window_cpu_start_;
+
+    stats.fps = static_cast<float>(window_frames_ / elapsed);
+    stats.cpu_percent = static_cast<float>(100.0 * cpu / elapsed);
+    if (window_frames_ > 0) {
+        stats.frame_ms_avg = static_cast<float>(1000.0 * window_frame_sum_ / window_frames_);
+        stats.frame_ms_max = static_cast<float>(1000.0 * window_frame_max_);
+        stats.work_ms_avg = static_cast<float>(1000.0 * window_work_sum_ / window_frames_);
+    }
+
+    resetWindow(now);
+}
+
+void FramePacer::resetWindow(Clock::time_point now) {
+    window_start_ = now;
+    window_cpu_start_ = processCpuSeconds();
+    window_frames_ = 0;
+    window_frame_sum_ = 0.0;
+    window_frame_max_ = 0.0;
+    window_work_sum_ = 0.0;
+}
+
+} // namespace ev_sim
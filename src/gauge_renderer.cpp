@@ -0,0 +1,283 @@
+#include "gauge_renderer.hpp"
+#include <imgui_internal.h>
+#include <cmath>
+#include <cstdio>
+
+// MSVC may treat double->float as warning-as-error; use a float PI constant
+static constexpr float kPi = 3.14159265358979323846f;
+
+namespace ev_sim {
+
+namespace {
+
+// Gauge sweep: left (PI) to right (0) across the top half
+constexpr float kStartAngle = kPi;
+constexpr float kEndAngle = 0.0f;
+
+const ImU32 kArcBackgroundColor = IM_COL32(60, 60, 60, 255);
+const ImU32 kNeedleColor = IM_COL32(255, 255, 255, 255);
+const ImU32 kHubOuterColor = IM_COL32(80, 80, 80, 255);
+const ImU32 kHubInnerColor = IM_COL32(200, 200, 200, 255);
+const ImU32 kTickColor = IM_COL32(150, 150, 150, 255);
+const ImU32 kValueTextColor = IM_COL32(255, 255, 255, 255);
+const ImU32 kLabelColor = IM_COL32(180, 180, 180, 255);
+const ImU32 kScaleTextColor = IM_COL32(120, 120, 120, 255);
+
+// Large clip rect so text around the origin is never CPU-culled while baking
+constexpr float kBakeClipExtent = 1.0e4f;
+
+} // namespace
+
+void drawRPMGauge(const char* label, float value, float max_value, const ImVec4& color, float size) {
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+    ImVec2 canvas_size = ImVec2(size, size * 0.6f);
+
+    ImGui::InvisibleButton(label, canvas_size);
+
+    ImVec2 center = ImVec2(canvas_pos.x + size * 0.5f, canvas_pos.y + size * 0.35f);
+    float radius = size * 0.4f;
+
+    const int segments = 32;
+    const float start_angle = kPi;
+    const float end_angle = 0.0f;
+
+    for (int i = 0; i < segments; i++) {
+        float a1 = start_angle + (end_angle - start_angle) * i / segments;
+        float a2 = start_angle + (end_angle - start_angle) * (i + 1) / segments;
+
+        ImVec2 p1 = ImVec2(center.x + cosf(a1) * radius, center.y + sinf(a1) * radius);
+        ImVec2 p2 = ImVec2(center.x + cosf(a2) * radius, center.y + sinf(a2) * radius);
+
+        draw_list->AddLine(p1, p2, IM_COL32(60, 60, 60, 255), 8.0f);
+    }
+
+    float percentage = fminf(value / max_value, 1.0f);
+    float value_angle = start_angle + (end_angle - start_angle) * percentage;
+
+    int value_segments = (int)(segments * percentage);
+    for (int i = 0; i < value_segments; i++) {
+        float a1 = start_angle + (end_angle - start_angle) * i / segments;
+        float a2 = start_angle + (end_angle - start_angle) * (i + 1) / segments;
+
+        ImVec2 p1 = ImVec2(center.x + cosf(a1) * radius, center.y + sinf(a1) * radius);
+        ImVec2 p2 = ImVec2(center.x + cosf(a2) * radius, center.y + sinf(a2) * radius);
+
+        ImU32 col = ImGui::ColorConvertFloat4ToU32(color);
+        draw_list->AddLine(p1, p2, col, 8.0f);
+    }
+
+    ImVec2 needle_end = ImVec2(center.x + cosf(value_angle) * (radius - 10),
+                               center.y + sinf(value_angle) * (radius - 10));
+    draw_list->AddLine(center, needle_end, IM_COL32(255, 255, 255, 255), 3.0f);
+
+    draw_list->AddCircleFilled(center, 6.0f, IM_COL32(80, 80, 80, 255));
+    draw_list->AddCircleFilled(center, 4.0f, IM_COL32(200, 200, 200, 255));
+
+    for (int i = 0; i <= 10; i++) {
+        float mark_angle = start_angle + (end_angle - start_angle) * i / 10.0f;
+        ImVec2 mark_inner = ImVec2(center.x + cosf(mark_angle) * (radius - 15),
+                                   center.y + sinf(mark_angle) * (radius - 15));
+        ImVec2 mark_outer = ImVec2(center.x + cosf(mark_angle) * radius,
+                                   center.y + sinf(mark_angle) * radius);
+
+        float thickness = (i % 5 == 0) ? 2.0f : 1.0f;
+        draw_list->AddLine(mark_inner, mark_outer, IM_COL32(150, 150, 150, 255), thickness);
+    }
+
+    ImVec2 text_size = ImGui::CalcTextSize("00000");
+    ImVec2 text_pos = ImVec2(center.x - text_size.x * 0.5f, center.y - 10);
+
+    char value_text[32];
+    snprintf(value_text, sizeof(value_text), "%.0f", value);
+    draw_list->AddText(text_pos, IM_COL32(255, 255, 255, 255), value_text);
+
+    ImVec2 label_size = ImGui::CalcTextSize(label);
+    ImVec2 label_pos = ImVec2(center.x - label_size.x * 0.5f, center.y + 15);
+    draw_list->AddText(label_pos, IM_COL32(180, 180, 180, 255), label);
+
+    char max_text[16];
+    snprintf(max_text, sizeof(max_text), "%.0f", max_value);
+    ImVec2 max_size = ImGui::CalcTextSize(max_text);
+    ImVec2 max_pos = ImVec2(center.x + radius - max_size.x, center.y + 5);
+    draw_list->AddText(max_pos, IM_COL32(120, 120, 120, 255), max_text);
+
+    draw_list->AddText(ImVec2(center.x - radius, center.y + 5), IM_COL32(120, 120, 120, 255), "0");
+}
+
+GaugeRenderer::GaugeRenderer(const char* label, float max_value, const ImVec4& color, float size)
+    : label_(label)
+    , max_value_(max_value)
+    , color_(ImGui::ColorConvertFloat4ToU32(color))
+    , size_(size)
+    , value_text_offset_(0.0f, 0.0f)
+    , dial_valid_(false)
+    , dial_font_(nullptr)
+    , dial_font_size_(0.0f)
+    , dial_texture_()
+    , dial_flags_(0)
+    , last_value_(-1)
+{
+    value_text_[0] = '\0';
+}
+
+void GaugeRenderer::setSize(float size) {
+    if (size != size_) {
+        size_ = size;
+        dial_valid_ = false;
+    }
+}
+
+void GaugeRenderer::setMaxValue(float max_value) {
+    if (max_value != max_value_) {
+        max_value_ = max_value;
+        dial_valid_ = false;
+    }
+}
+
+bool GaugeRenderer::dialIsStale() const {
+    // Font atlas rebuilds or style changes (anti-aliasing) invalidate baked vertices
+    const ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+    return !dial_valid_
+        || dial_font_ != ImGui::GetFont()
+        || dial_font_size_ != ImGui::GetFontSize()
+        || dial_texture_ != ImGui::GetIO().Fonts->TexID
+        || dial_flags_ != shared->InitialFlags;
+}
+
+void GaugeRenderer::rebuildDial() {
+    const float radius = size_ * 0.4f;
+
+    // Unit-circle samples, scaled once for this size
+    for (int i = 0; i <= kSegments; i++) {
+        float angle = kStartAngle + (kEndAngle - kStartAngle) * i / kSegments;
+        arc_points_[i] = ImVec2(cosf(angle) * radius, sinf(angle) * radius);
+    }
+
+    // Tessellate the static parts around the origin in a scratch list
+    ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+    ImDrawList scratch(shared);
+    scratch._ResetForNewFrame();
+    scratch.PushClipRect(ImVec2(-kBakeClipExtent, -kBakeClipExtent), ImVec2(kBakeClipExtent, kBakeClipExtent));
+    scratch.PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+    // Under layer: background arc
+    for (int i = 0; i < kSegments; i++) {
+        scratch.AddLine(arc_points_[i], arc_points_[i + 1], kArcBackgroundColor, 8.0f);
+    }
+    dial_under_.vtx = scratch.VtxBuffer;
+    dial_under_.idx = scratch.IdxBuffer;
+
+    // Over layer: hub, tick marks and static labels
+    scratch._ResetForNewFrame();
+    scratch.PushClipRect(ImVec2(-kBakeClipExtent, -kBakeClipExtent), ImVec2(kBakeClipExtent, kBakeClipExtent));
+    scratch.PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+    const ImVec2 origin(0.0f, 0.0f);
+    scratch.AddCircleFilled(origin, 6.0f, kHubOuterColor);
+    scratch.AddCircleFilled(origin, 4.0f, kHubInnerColor);
+
+    for (int i = 0; i <= kTicks; i++) {
+        float mark_angle = kStartAngle + (kEndAngle - kStartAngle) * i / static_cast<float>(kTicks);
+        float c = cosf(mark_angle);
+        float s = sinf(mark_angle);
+        ImVec2 mark_inner = ImVec2(c * (radius - 15), s * (radius - 15));
+        ImVec2 mark_outer = ImVec2(c * radius, s * radius);
+
+        float thickness = (i % 5 == 0) ? 2.0f : 1.0f;
+        scratch.AddLine(mark_inner, mark_outer, kTickColor, thickness);
+    }
+
+    ImVec2 label_size = ImGui::CalcTextSize(label_.c_str());
+    scratch.AddText(ImVec2(-label_size.x * 0.5f, 15.0f), kLabelColor, label_.c_str());
+
+    char max_text[16];
+    snprintf(max_text, sizeof(max_text), "%.0f", max_value_);
+    ImVec2 max_size = ImGui::CalcTextSize(max_text);
+    scratch.AddText(ImVec2(radius - max_size.x, 5.0f), kScaleTextColor, max_text);
+    scratch.AddText(ImVec2(-radius, 5.0f), kScaleTextColor, "0");
+
+    dial_over_.vtx = scratch.VtxBuffer;
+    dial_over_.idx = scratch.IdxBuffer;
+
+    ImVec2 text_size = ImGui::CalcTextSize("00000");
+    value_text_offset_ = ImVec2(-text_size.x * 0.5f, -10.0f);
+
+    dial_valid_ = true;
+    dial_font_ = ImGui::GetFont();
+    dial_font_size_ = ImGui::GetFontSize();
+    dial_texture_ = ImGui::GetIO().Fonts->TexID;
+    dial_flags_ = shared->InitialFlags;
+}
+
+void GaugeRenderer::blitMesh(ImDrawList* draw_list, const Mesh& mesh, const ImVec2& offset) {
+    if (mesh.idx.Size == 0) {
+        return;
+    }
+
+    // PrimReserve may start a new command with a VtxOffset, so read the base index afterwards
+    draw_list->PrimReserve(mesh.idx.Size, mesh.vtx.Size);
+    const unsigned int base = draw_list->_VtxCurrentIdx;
+
+    ImDrawVert* vtx_out = draw_list->_VtxWritePtr;
+    for (int i = 0; i < mesh.vtx.Size; i++) {
+        const ImDrawVert& v = mesh.vtx[i];
+        vtx_out[i].pos = ImVec2(v.pos.x + offset.x, v.pos.y + offset.y);
+        vtx_out[i].uv = v.uv;
+        vtx_out[i].col = v.col;
+    }
+
+    ImDrawIdx* idx_out = draw_list->_IdxWritePtr;
+    for (int i = 0; i < mesh.idx.Size; i++) {
+        idx_out[i] = static_cast<ImDrawIdx>(base + mesh.idx[i]);
+    }
+
+    draw_list->_VtxWritePtr += mesh.vtx.Size;
+    draw_list->_IdxWritePtr += mesh.idx.Size;
+    draw_list->_VtxCurrentIdx += static_cast<unsigned int>(mesh.vtx.Size);
+}
+
+void GaugeRenderer::draw(float value) {
+    if (dialIsStale()) {
+        rebuildDial();
+    }
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+    ImVec2 canvas_size = ImVec2(size_, size_ * 0.6f);
+
+    ImGui::InvisibleButton(label_.c_str(), canvas_size);
+
+    ImVec2 center = ImVec2(canvas_pos.x + size_ * 0.5f, canvas_pos.y + size_ * 0.35f);
+    float radius = size_ * 0.4f;
+
+    blitMesh(draw_list, dial_under_, center);
+
+    // Value arc reuses the cached arc samples
+    float percentage = fminf(value / max_value_, 1.0f);
+    int value_segments = (int)(kSegments * percentage);
+    for (int i = 0; i < value_segments; i++) {
+        ImVec2 p1 = ImVec2(center.x + arc_points_[i].x, center.y + arc_points_[i].y);
+        ImVec2 p2 = ImVec2(center.x + arc_points_[i + 1].x, center.y + arc_points_[i + 1].y);
+        draw_list->AddLine(p1, p2, color_, 8.0f);
+    }
+
+    // Needle is the only per-frame trigonometry
+    float value_angle = kStartAngle + (kEndAngle - kStartAngle) * percentage;
+    ImVec2 needle_end = ImVec2(center.x + cosf(value_angle) * (radius - 10),
+                               center.y + sinf(value_angle) * (radius - 10));
+    draw_list->AddLine(center, needle_end, kNeedleColor, 3.0f);
+
+    blitMesh(draw_list, dial_over_, center);
+
+    // Reformat only when the displayed digits change
+    long rounded = lrintf(value);  // Same rounding as "%.0f"
+    if (rounded != last_value_ || value_text_[0] == '\0') {
+        snprintf(value_text_, sizeof(value_text_), "%.0f", value);
+        last_value_ = rounded;
+    }
+    draw_list->AddText(ImVec2(center.x + value_text_offset_.x, center.y + value_text_offset_.y),
+                       kValueTextColor, value_text_);
+}
+
+} // namespace ev_sim
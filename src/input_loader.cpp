@@ -0,0 +1,98 @@
+#include "input_loader.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace ev_sim {
+
+InputTrace::InputTrace()
+    : duration_(-1.0)
+{
+}
+
+bool InputTrace::add(double time, float throttle_percent, float clutch_pedal_percent, int gear) {
+    if (!samples_.empty() && time < samples_.back().time) {
+        return false;
+    }
+    InputSample sample;
+    sample.time = time;
+    sample.throttle_percent = throttle_percent;
+    sample.clutch_pedal_percent = clutch_pedal_percent;
+    sample.gear = gear;
+    samples_.push_back(sample);
+    return true;
+}
+
+bool InputTrace::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open file";
+        return false;
+    }
+
+    samples_.clear();
+    duration_ = -1.0;
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        // Three or four comma-separated numbers; a non-numeric first row is the header
+        const char* cursor = line.c_str() + first;
+        double values[4] = { 0.0, 0.0, 0.0, 0.0 };
+        int parsed = 0;
+        while (parsed < 4) {
+            char* end = nullptr;
+            values[parsed] = std::strtod(cursor, &end);
+            if (end == cursor) {
+                break;
+            }
+            parsed++;
+            cursor = end;
+            while (*cursor == ' ' || *cursor == '\t') cursor++;
+            if (*cursor != ',') {
+                break;
+            }
+            cursor++;
+        }
+        if (parsed == 0 && samples_.empty()) {
+            continue;
+        }
+        if (parsed < 3) {
+            error = "line " + std::to_string(line_number) + ": expected time,throttle,clutch[,gear]";
+            return false;
+        }
+        if (!add(values[0], static_cast<float>(values[1]), static_cast<float>(values[2]),
+                 static_cast<int>(values[3]))) {
+            error = "line " + std::to_string(line_number) + ": time goes backwards";
+            return false;
+        }
+    }
+
+    if (samples_.empty()) {
+        error = "no samples";
+        return false;
+    }
+    return true;
+}
+
+const InputSample& InputTrace::sampleAt(double t) const {
+    // Last sample at or before t
+    auto it = std::upper_bound(samples_.begin(), samples_.end(), t,
+                               [](double time, const InputSample& sample) { return time < sample.time; });
+    return it == samples_.begin() ? samples_.front() : *(it - 1);
+}
+
+double InputTrace::duration() const {
+    if (duration_ >= 0.0) {
+        return duration_;
+    }
+    return samples_.empty() ? 0.0 : samples_.back().time;
+}
+
+} // namespace ev_sim
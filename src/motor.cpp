@@ -0,0 +1,38 @@
+#include "motor.hpp"
+#include <algorithm>
+
+namespace ev_sim {
+
+using physics::kRadPerSecToRPM;
+
+EfficiencyMap motorEfficiencyMap(const MotorParameters& params) {
+    const int rpm_points = std::max(params.rpm_points, 2);
+    const int torque_points = std::max(params.torque_points, 2);
+    std::vector<float> values(static_cast<size_t>(rpm_points) * torque_points);
+    for (int row = 0; row < rpm_points; row++) {
+        const float speed = params.max_rpm * row / (rpm_points - 1) / kRadPerSecToRPM;   // rad/s
+        for (int column = 0; column < torque_points; column++) {
+            const float torque = params.max_torque * column / (torque_points - 1);
+            const float mechanical = torque * speed;
+            const float loss = params.copper_loss * torque * torque + params.iron_loss * speed +
+                               params.windage_loss * speed * speed + params.inverter_loss;
+            const float efficiency = mechanical / std::max(mechanical + loss, 1e-6f);
+            values[row * torque_points + column] = std::clamp(efficiency, params.min_efficiency, 1.0f);
+        }
+    }
+    return EfficiencyMap(params.max_rpm, params.max_torque, rpm_points, torque_points, values);
+}
+
+TractionMotor::TractionMotor(const MotorParameters& params)
+    : TractionMotor(motorEfficiencyMap(params))
+{
+}
+
+TractionMotor::TractionMotor(const EfficiencyMap& map)
+    : map_(map)
+    , electrical_power_(0.0f)
+    , efficiency_(1.0f)
+{
+}
+
+} // namespace ev_sim
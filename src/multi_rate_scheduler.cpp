@@ -0,0 +1,63 @@
+#include "multi_rate_scheduler.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace ev_sim {
+
+MultiRateScheduler::MultiRateScheduler(double base_period)
+    : base_period_(std::max(base_period, 1e-6))
+    , ticks_(0)
+    , pending_(0.0)
+{
+}
+
+int MultiRateScheduler::addTask(const std::string& name, double period, std::function<void(double)> task) {
+    ScheduledTask entry;
+    entry.name = name;
+    entry.divider = std::max(static_cast<int>(std::lround(period / base_period_)), 1);
+    entry.period = entry.divider * base_period_;
+    entry.runs = 0;
+    entry.run = std::move(task);
+    tasks_.push_back(std::move(entry));
+    return static_cast<int>(tasks_.size()) - 1;
+}
+
+void MultiRateScheduler::reset() {
+    ticks_ = 0;
+    pending_ = 0.0;
+    for (ScheduledTask& task : tasks_) {
+        task.runs = 0;
+    }
+}
+
+void MultiRateScheduler::setTicks(uint64_t ticks) {
+    ticks_ = ticks;
+    pending_ = 0.0;
+}
+
+void MultiRateScheduler::tick() {
+    EV_SIM_TRACE_ZONE("MultiRateScheduler::tick", "physics");
+
+    ticks_++;
+    for (ScheduledTask& task : tasks_) {
+        if (ticks_ % static_cast<uint64_t>(task.divider) == 0) {
+            task.run(task.period);
+            task.runs++;
+        }
+    }
+}
+
+int MultiRateScheduler::advance(double duration) {
+    pending_ += std::max(duration, 0.0);
+    // Tolerate the rounding of accumulated frame times
+    const int count = static_cast<int>(std::floor(pending_ / base_period_ + 1e-9));
+    pending_ = std::max(pending_ - count * base_period_, 0.0);
+    for (int i = 0; i < count; i++) {
+        tick();
+    }
+    return count;
+}
+
+} // namespace ev_sim
@@ -0,0 +1,139 @@
+#include "perf_counters.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace ev_sim {
+
+namespace {
+
+constexpr int kEventCount = static_cast<int>(PerfEvent::Count);
+
+#if defined(__linux__)
+// perf_event_attr config per PerfEvent, in enum order
+const uint64_t kEventConfig[kEventCount] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_MISSES,
+};
+
+int openEvent(uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Calling thread, any CPU, no group
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+} // namespace
+
+const char* perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::Cycles:       return "cycles";
+        case PerfEvent::Instructions: return "instructions";
+        case PerfEvent::BranchMisses: return "branch_misses";
+        case PerfEvent::CacheMisses:  return "cache_misses";
+        default:                      return "unknown";
+    }
+}
+
+PerfCounters::PerfCounters() {
+    for (int& fd : fds_) {
+        fd = -1;
+    }
+
+#if defined(__linux__)
+    int first_error = 0;
+    for (int i = 0; i < kEventCount; i++) {
+        fds_[i] = openEvent(kEventConfig[i]);
+        if (fds_[i] < 0 && first_error == 0) {
+            first_error = errno;
+        }
+    }
+    if (!isAvailable()) {
+        reason_ = std::string("perf_event_open failed: ") + std::strerror(first_error);
+        if (first_error == EACCES || first_error == EPERM) {
+            reason_ += " (check /proc/sys/kernel/perf_event_paranoid)";
+        } else if (first_error == ENOENT || first_error == EOPNOTSUPP) {
+            reason_ += " (no hardware PMU exposed, e.g. in a virtual machine)";
+        }
+    }
+#else
+    reason_ = "hardware counters are only supported on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int i = 0; i < kEventCount; i++) {
+        if (fds_[i] < 0) {
+            continue;
+        }
+        // value, time_enabled, time_running
+        uint64_t data[3] = {};
+        if (read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+            continue;
+        }
+        // Scale up when the counter was multiplexed with other events
+        double scaled = static_cast<double>(data[0]);
+        if (data[2] < data[1]) {
+            scaled *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        }
+        sample.value[i] = static_cast<uint64_t>(scaled);
+        sample.valid[i] = true;
+    }
+#endif
+    return sample;
+}
+
+} // namespace ev_sim
@@ -0,0 +1,394 @@
+#include "plot_renderer.hpp"
+#include <SDL3/SDL_opengl.h>
+#include <algorithm>
+#include <type_traits>
+
+namespace ev_sim {
+
+namespace {
+
+const char* kVertexShaderSource = R"(#version 330 core
+layout(location = 0) in float a_value;
+uniform int u_head;       // Slot of the oldest sample
+uniform int u_capacity;   // Samples in the ring
+uniform vec2 u_range;     // Value mapped to bottom/top
+void main() {
+    // Ring position -> age order; the mirror slot (== capacity) continues past the last slot
+    int rel = gl_VertexID - u_head;
+    if (rel < 0) rel += u_capacity;
+    float x = float(rel) / float(max(u_capacity - 1, 1));
+    float y = clamp((a_value - u_range.x) / (u_range.y - u_range.x), 0.0, 1.0);
+    gl_Position = vec4(x * 2.0 - 1.0, y * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* kFragmentShaderSource = R"(#version 330 core
+uniform vec4 u_color;
+out vec4 frag_color;
+void main() {
+    frag_color = u_color;
+}
+)";
+
+} // namespace
+
+// GL 3.3 entry points and objects, resolved at initGL()
+struct PlotRenderer::GLState {
+    PFNGLCREATESHADERPROC CreateShader = nullptr;
+    PFNGLSHADERSOURCEPROC ShaderSource = nullptr;
+    PFNGLCOMPILESHADERPROC CompileShader = nullptr;
+    PFNGLGETSHADERIVPROC GetShaderiv = nullptr;
+    PFNGLDELETESHADERPROC DeleteShader = nullptr;
+    PFNGLCREATEPROGRAMPROC CreateProgram = nullptr;
+    PFNGLATTACHSHADERPROC AttachShader = nullptr;
+    PFNGLLINKPROGRAMPROC LinkProgram = nullptr;
+    PFNGLGETPROGRAMIVPROC GetProgramiv = nullptr;
+    PFNGLDELETEPROGRAMPROC DeleteProgram = nullptr;
+    PFNGLUSEPROGRAMPROC UseProgram = nullptr;
+    PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation = nullptr;
+    PFNGLUNIFORM1IPROC Uniform1i = nullptr;
+    PFNGLUNIFORM2FPROC Uniform2f = nullptr;
+    PFNGLUNIFORM4FPROC Uniform4f = nullptr;
+    PFNGLGENVERTEXARRAYSPROC GenVertexArrays = nullptr;
+    PFNGLBINDVERTEXARRAYPROC BindVertexArray = nullptr;
+    PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays = nullptr;
+    PFNGLGENBUFFERSPROC GenBuffers = nullptr;
+    PFNGLBINDBUFFERPROC BindBuffer = nullptr;
+    PFNGLBUFFERDATAPROC BufferData = nullptr;
+    PFNGLBUFFERSUBDATAPROC BufferSubData = nullptr;
+    PFNGLDELETEBUFFERSPROC DeleteBuffers = nullptr;
+    PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer = nullptr;
+    PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray = nullptr;
+
+    GLuint program = 0;
+    GLuint vao = 0;
+    GLint loc_head = -1;
+    GLint loc_capacity = -1;
+    GLint loc_range = -1;
+    GLint loc_color = -1;
+    float max_line_width = 1.0f;
+};
+
+PlotRenderer::PlotRenderer(int capacity)
+    : capacity_(std::max(capacity, 2))
+    , draw_calls_frame_(-1)
+    , gl_ready_(false)
+    , gpu_enabled_(false)
+    , gl_(nullptr)
+{
+    polyline_.reserve(capacity_);
+}
+
+PlotRenderer::~PlotRenderer() {
+    // GL objects must be released with shutdownGL() while the context is current
+    delete gl_;
+}
+
+int PlotRenderer::addChannel(ImU32 color, float min_value, float max_value, float initial_value, float thickness) {
+    Channel channel;
+    channel.samples.assign(capacity_ + 1, initial_value);
+    channel.color = color;
+    channel.min_value = min_value;
+    channel.max_value = max_value;
+    channel.thickness = thickness;
+    channels_.push_back(channel);
+    return static_cast<int>(channels_.size()) - 1;
+}
+
+void PlotRenderer::push(int channel_index, float value) {
+    Channel& channel = channels_[channel_index];
+    channel.samples[channel.head] = value;
+    if (channel.head == 0) {
+        channel.samples[capacity_] = value;  // Keep the mirror slot in sync
+    }
+    channel.head = (channel.head + 1) % capacity_;
+    channel.written++;
+}
+
+float PlotRenderer::sample(int channel_index, int index) const {
+    const Channel& channel = channels_[channel_index];
+    return channel.samples[(channel.head + index) % capacity_];
+}
+
+float PlotRenderer::latest(int channel_index) const {
+    return sample(channel_index, capacity_ - 1);
+}
+
+bool PlotRenderer::initGL(GLProcLoader loader) {
+    if (gl_ready_ || !loader) {
+        return gl_ready_;
+    }
+
+    GLState* gl = new GLState();
+    bool loaded = true;
+    auto load = [&](auto& fn, const char* name) {
+        fn = reinterpret_cast<std::remove_reference_t<decltype(fn)>>(loader(name));
+        loaded = loaded && fn != nullptr;
+    };
+    load(gl->CreateShader, "glCreateShader");
+    load(gl->ShaderSource, "glShaderSource");
+    load(gl->CompileShader, "glCompileShader");
+    load(gl->GetShaderiv, "glGetShaderiv");
+    load(gl->DeleteShader, "glDeleteShader");
+    load(gl->CreateProgram, "glCreateProgram");
+    load(gl->AttachShader, "glAttachShader");
+    load(gl->LinkProgram, "glLinkProgram");
+    load(gl->GetProgramiv, "glGetProgramiv");
+    load(gl->DeleteProgram, "glDeleteProgram");
+    load(gl->UseProgram, "glUseProgram");
+    load(gl->GetUniformLocation, "glGetUniformLocation");
+    load(gl->Uniform1i, "glUniform1i");
+    load(gl->Uniform2f, "glUniform2f");
+    load(gl->Uniform4f, "glUniform4f");
+    load(gl->GenVertexArrays, "glGenVertexArrays");
+    load(gl->BindVertexArray, "glBindVertexArray");
+    load(gl->DeleteVertexArrays, "glDeleteVertexArrays");
+    load(gl->GenBuffers, "glGenBuffers");
+    load(gl->BindBuffer, "glBindBuffer");
+    load(gl->BufferData, "glBufferData");
+    load(gl->BufferSubData, "glBufferSubData");
+    load(gl->DeleteBuffers, "glDeleteBuffers");
+    load(gl->VertexAttribPointer, "glVertexAttribPointer");
+    load(gl->EnableVertexAttribArray, "glEnableVertexAttribArray");
+    if (!loaded) {
+        delete gl;
+        return false;
+    }
+
+    // Compile and link the line shader
+    auto compile = [gl](GLenum type, const char* source) -> GLuint {
+        GLuint shader = gl->CreateShader(type);
+        gl->ShaderSource(shader, 1, &source, nullptr);
+        gl->CompileShader(shader);
+        GLint ok = GL_FALSE;
+        gl->GetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (ok != GL_TRUE) {
+            gl->DeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    };
+    GLuint vs = compile(GL_VERTEX_SHADER, kVertexShaderSource);
+    GLuint fs = compile(GL_FRAGMENT_SHADER, kFragmentShaderSource);
+    if (vs != 0 && fs != 0) {
+        gl->program = gl->CreateProgram();
+        gl->AttachShader(gl->program, vs);
+        gl->AttachShader(gl->program, fs);
+        gl->LinkProgram(gl->program);
+        GLint ok = GL_FALSE;
+        gl->GetProgramiv(gl->program, GL_LINK_STATUS, &ok);
+        if (ok != GL_TRUE) {
+            gl->DeleteProgram(gl->program);
+            gl->program = 0;
+        }
+    }
+    if (vs != 0) gl->DeleteShader(vs);
+    if (fs != 0) gl->DeleteShader(fs);
+    if (gl->program == 0) {
+        delete gl;
+        return false;
+    }
+
+    gl->loc_head = gl->GetUniformLocation(gl->program, "u_head");
+    gl->loc_capacity = gl->GetUniformLocation(gl->program, "u_capacity");
+    gl->loc_range = gl->GetUniformLocation(gl->program, "u_range");
+    gl->loc_color = gl->GetUniformLocation(gl->program, "u_color");
+    gl->GenVertexArrays(1, &gl->vao);
+
+    // Wide lines are optional in core profile; clamp to what the driver reports
+    GLfloat line_range[2] = { 1.0f, 1.0f };
+    glGetFloatv(GL_ALIASED_LINE_WIDTH_RANGE, line_range);
+    gl->max_line_width = std::max(line_range[1], 1.0f);
+    while (glGetError() != GL_NO_ERROR) {}
+
+    gl_ = gl;
+    gl_ready_ = true;
+    gpu_enabled_ = true;
+    return true;
+}
+
+void PlotRenderer::shutdownGL() {
+    if (!gl_ready_) {
+        return;
+    }
+    for (Channel& channel : channels_) {
+        if (channel.vbo != 0) {
+            gl_->DeleteBuffers(1, &channel.vbo);
+            channel.vbo = 0;
+        }
+    }
+    gl_->DeleteVertexArrays(1, &gl_->vao);
+    gl_->DeleteProgram(gl_->program);
+    delete gl_;
+    gl_ = nullptr;
+    gl_ready_ = false;
+    gpu_enabled_ = false;
+}
+
+void PlotRenderer::uploadPending(Channel& channel) {
+    const GLsizeiptr slot_size = static_cast<GLsizeiptr>(sizeof(float));
+
+    if (channel.vbo == 0) {
+        gl_->GenBuffers(1, &channel.vbo);
+        gl_->BindBuffer(GL_ARRAY_BUFFER, channel.vbo);
+        gl_->BufferData(GL_ARRAY_BUFFER, slot_size * (capacity_ + 1), channel.samples.data(), GL_DYNAMIC_DRAW);
+        channel.uploaded = channel.written;
+        return;
+    }
+
+    gl_->BindBuffer(GL_ARRAY_BUFFER, channel.vbo);
+    const uint64_t pending = channel.written - channel.uploaded;
+    if (pending == 0) {
+        return;
+    }
+    if (pending >= static_cast<uint64_t>(capacity_)) {
+        gl_->BufferSubData(GL_ARRAY_BUFFER, 0, slot_size * (capacity_ + 1), channel.samples.data());
+    } else {
+        // Only the slots written since the last upload (at most two ranges around the wrap)
+        const int count = static_cast<int>(pending);
+        const int first = (channel.head - count + capacity_) % capacity_;
+        const int run = std::min(count, capacity_ - first);
+        gl_->BufferSubData(GL_ARRAY_BUFFER, slot_size * first, slot_size * run, channel.samples.data() + first);
+        if (run < count) {
+            gl_->BufferSubData(GL_ARRAY_BUFFER, 0, slot_size * (count - run), channel.samples.data());
+        }
+        if (first == 0 || run < count) {
+            gl_->BufferSubData(GL_ARRAY_BUFFER, slot_size * capacity_, slot_size, channel.samples.data() + capacity_);
+        }
+    }
+    channel.uploaded = channel.written;
+}
+
+void PlotRenderer::draw(const char* id, ImVec2 size, const int* channels, int channel_count, ImU32 background) {
+    ImVec2 avail = ImGui::GetContentRegionAvail();
+    if (size.x <= 0.0f) size.x = std::max(avail.x + size.x, 4.0f);
+    if (size.y <= 0.0f) size.y = std::max(avail.y + size.y, 4.0f);
+
+    ImVec2 rect_min = ImGui::GetCursorScreenPos();
+    ImVec2 rect_max = ImVec2(rect_min.x + size.x, rect_min.y + size.y);
+    ImGui::InvisibleButton(id, size);
+
+    if (background != 0) {
+        ImGui::GetWindowDrawList()->AddRectFilled(rect_min, rect_max, background);
+    }
+    drawInRect(rect_min, rect_max, channels, channel_count);
+}
+
+void PlotRenderer::drawInRect(const ImVec2& rect_min, const ImVec2& rect_max, const int* channels, int channel_count) {
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+
+    if (!gpu_enabled_) {
+        drawCPU(draw_list, rect_min, rect_max, channels, channel_count);
+        return;
+    }
+
+    // The callback only carries a pointer (the overload that copies a
+    // payload needs ImGui 1.91.4), so the payloads live in draw_calls_ until
+    // the frame has been rendered, i.e. until a draw in a later frame
+    if (draw_calls_frame_ != ImGui::GetFrameCount()) {
+        draw_calls_frame_ = ImGui::GetFrameCount();
+        draw_calls_.clear();
+    }
+
+    // A payload holds a fixed number of channels: longer lists go out as
+    // several callbacks, in order, so later channels still draw on top
+    for (int first = 0; first < channel_count; first += kMaxChannelsPerDraw) {
+        draw_calls_.emplace_back();
+        DrawCall& call = draw_calls_.back();
+        call.renderer = this;
+        call.rect_min = rect_min;
+        call.rect_max = rect_max;
+        call.channel_count = std::min(channel_count - first, kMaxChannelsPerDraw);
+        for (int i = 0; i < call.channel_count; i++) {
+            call.channels[i] = channels[first + i];
+        }
+        draw_list->AddCallback(&PlotRenderer::renderCallback, &call);
+    }
+    draw_list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+}
+
+void PlotRenderer::drawCPU(ImDrawList* draw_list, const ImVec2& rect_min, const ImVec2& rect_max,
+                           const int* channels, int channel_count) {
+    const float width = rect_max.x - rect_min.x;
+    const float height = rect_max.y - rect_min.y;
+
+    for (int c = 0; c < channel_count; c++) {
+        const Channel& channel = channels_[channels[c]];
+        const float inv_range = 1.0f / (channel.max_value - channel.min_value);
+
+        polyline_.resize(capacity_);
+        for (int i = 0; i < capacity_; i++) {
+            float t = (sample(channels[c], i) - channel.min_value) * inv_range;
+            t = std::clamp(t, 0.0f, 1.0f);
+            polyline_[i] = ImVec2(rect_min.x + width * i / (capacity_ - 1),
+                                  rect_min.y + height * (1.0f - t));
+        }
+        draw_list->AddPolyline(polyline_.data(), capacity_, channel.color, 0, channel.thickness);
+    }
+}
+
+void PlotRenderer::renderCallback(const ImDrawList* /*parent_list*/, const ImDrawCmd* cmd) {
+    const DrawCall* call = static_cast<const DrawCall*>(cmd->UserCallbackData);
+    call->renderer->renderGL(*call, cmd);
+}
+
+void PlotRenderer::renderGL(const DrawCall& call, const ImDrawCmd* cmd) {
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+    const ImVec2 display_pos = draw_data->DisplayPos;
+    const ImVec2 scale = draw_data->FramebufferScale;
+    const float fb_height = draw_data->DisplaySize.y * scale.y;
+
+    // ImGui coordinates (top-left origin) -> GL framebuffer coordinates (bottom-left origin)
+    auto to_fb_rect = [&](float x0, float y0, float x1, float y1, GLint* out) {
+        out[0] = static_cast<GLint>((x0 - display_pos.x) * scale.x);
+        out[1] = static_cast<GLint>(fb_height - (y1 - display_pos.y) * scale.y);
+        out[2] = static_cast<GLint>((x1 - x0) * scale.x);
+        out[3] = static_cast<GLint>((y1 - y0) * scale.y);
+    };
+
+    GLint clip[4];
+    to_fb_rect(cmd->ClipRect.x, cmd->ClipRect.y, cmd->ClipRect.z, cmd->ClipRect.w, clip);
+    if (clip[2] <= 0 || clip[3] <= 0) {
+        return;
+    }
+    // Inset by a pixel so lines at the extremes stay inside the plot frame
+    GLint viewport[4];
+    to_fb_rect(call.rect_min.x + 1.0f, call.rect_min.y + 1.0f, call.rect_max.x - 1.0f, call.rect_max.y - 1.0f, viewport);
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(clip[0], clip[1], clip[2], clip[3]);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    gl_->UseProgram(gl_->program);
+    gl_->BindVertexArray(gl_->vao);
+    gl_->Uniform1i(gl_->loc_capacity, capacity_);
+
+    for (int c = 0; c < call.channel_count; c++) {
+        Channel& channel = channels_[call.channels[c]];
+        uploadPending(channel);
+
+        gl_->VertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), nullptr);
+        gl_->EnableVertexAttribArray(0);
+
+        const ImVec4 color = ImGui::ColorConvertU32ToFloat4(channel.color);
+        gl_->Uniform4f(gl_->loc_color, color.x, color.y, color.z, color.w);
+        gl_->Uniform2f(gl_->loc_range, channel.min_value, channel.max_value);
+        gl_->Uniform1i(gl_->loc_head, channel.head);
+        glLineWidth(std::min(channel.thickness * scale.x, gl_->max_line_width));
+
+        // Oldest run [head, capacity] (slot capacity mirrors slot 0), then newest run [0, head)
+        if (channel.head == 0) {
+            glDrawArrays(GL_LINE_STRIP, 0, capacity_);
+        } else {
+            glDrawArrays(GL_LINE_STRIP, channel.head, capacity_ - channel.head + 1);
+            if (channel.head > 1) {
+                glDrawArrays(GL_LINE_STRIP, 0, channel.head);
+            }
+        }
+    }
+
+    glLineWidth(1.0f);
+    gl_->BindVertexArray(0);
+}
+
+} // namespace ev_sim
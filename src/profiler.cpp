@@ -0,0 +1,97 @@
+#include "profiler.hpp"
+
+#if EV_SIM_PROFILER
+
+namespace ev_sim {
+
+const char* profilePhaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::EventPoll:  return "Event poll";
+        case ProfilePhase::Input:      return "Input";
+        case ProfilePhase::Physics:    return "Physics";
+        case ProfilePhase::ImGuiBuild: return "ImGui build";
+        case ProfilePhase::GLRender:   return "GL render";
+        case ProfilePhase::Swap:       return "Swap";
+        case ProfilePhase::Idle:       return "Idle";
+        default:                       return "Unknown";
+    }
+}
+
+FrameProfiler::FrameProfiler()
+    : frame_head_(0)
+    , frame_count_(0)
+    , physics_ms_()
+    , physics_head_(0)
+    , physics_count_(0)
+    , current_phase_(ProfilePhase::EventPoll)
+    , frame_open_(false)
+    , total_frames_(0)
+{
+}
+
+void FrameProfiler::beginFrame() {
+    current_ = FrameRecord();
+    current_phase_ = ProfilePhase::EventPoll;
+    phase_start_ = Clock::now();
+    frame_open_ = true;
+}
+
+void FrameProfiler::mark(ProfilePhase phase) {
+    if (!frame_open_) {
+        return;
+    }
+    const Clock::time_point now = Clock::now();
+    current_.phase_ms[static_cast<int>(current_phase_)] +=
+        std::chrono::duration<float, std::milli>(now - phase_start_).count();
+    current_phase_ = phase;
+    phase_start_ = now;
+}
+
+void FrameProfiler::endFrame() {
+    if (!frame_open_) {
+        return;
+    }
+    mark(current_phase_);
+    frame_open_ = false;
+
+    float total = 0.0f;
+    for (float ms : current_.phase_ms) {
+        total += ms;
+    }
+    current_.total_ms = total;
+    current_.frame_index = total_frames_++;
+
+    frames_[frame_head_] = current_;
+    frame_head_ = (frame_head_ + 1) % kHistory;
+    if (frame_count_ < kHistory) {
+        frame_count_++;
+    }
+
+    if (current_.total_ms > worst_frame_.total_ms) {
+        worst_frame_ = current_;
+    }
+}
+
+void FrameProfiler::cancelFrame() {
+    frame_open_ = false;
+}
+
+void FrameProfiler::recordPhysicsStep(double seconds) {
+    physics_ms_[physics_head_] = static_cast<float>(seconds * 1000.0);
+    physics_head_ = (physics_head_ + 1) % kPhysicsHistory;
+    if (physics_count_ < kPhysicsHistory) {
+        physics_count_++;
+    }
+}
+
+const FrameRecord& FrameProfiler::frame(int index) const {
+    return frames_[(frame_head_ - frame_count_ + index + kHistory) % kHistory];
+}
+
+float FrameProfiler::physicsStepMs(int index) const {
+    return physics_ms_[(physics_head_ - physics_count_ + index + kPhysicsHistory) % kPhysicsHistory];
+}
+
+} // namespace ev_sim
+
+#endif // EV_SIM_PROFILER
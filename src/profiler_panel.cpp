@@ -0,0 +1,241 @@
+#include "profiler_panel.hpp"
+
+#if EV_SIM_PROFILER
+
+#include <algorithm>
+#include <chrono>
+
+namespace ev_sim {
+
+namespace {
+
+constexpr int kPhaseCount = static_cast<int>(ProfilePhase::Count);
+constexpr int kWorstMarkers = 5;    // Worst frames highlighted in the rolling view
+
+// One color per phase, in ProfilePhase order
+const ImU32 kPhaseColors[kPhaseCount] = {
+    IM_COL32(120, 170, 255, 255),   // Event poll
+    IM_COL32(0, 220, 120, 255),     // Input
+    IM_COL32(255, 90, 90, 255),     // Physics
+    IM_COL32(255, 200, 60, 255),    // ImGui build
+    IM_COL32(200, 120, 255, 255),   // GL render
+    IM_COL32(255, 140, 0, 255),     // Swap
+    IM_COL32(90, 90, 90, 255),      // Idle
+};
+
+} // namespace
+
+ProfilerPanel::ProfilerPanel()
+    : total_vtx_(0)
+    , total_idx_(0)
+    , budget_ms_(1000.0f / 60.0f)
+    , panel_build_ms_(0.0f)
+{
+}
+
+void ProfilerPanel::captureDrawData(const ImDrawData* draw_data) {
+    draw_lists_.clear();
+    total_vtx_ = 0;
+    total_idx_ = 0;
+    if (!draw_data) {
+        return;
+    }
+
+    for (int i = 0; i < draw_data->CmdListsCount; i++) {
+        const ImDrawList* list = draw_data->CmdLists[i];
+        DrawListStats stats;
+        stats.owner = list->_OwnerName ? list->_OwnerName : "(unnamed)";
+        stats.vtx_count = list->VtxBuffer.Size;
+        stats.idx_count = list->IdxBuffer.Size;
+        stats.cmd_count = list->CmdBuffer.Size;
+        draw_lists_.push_back(stats);
+        total_vtx_ += stats.vtx_count;
+        total_idx_ += stats.idx_count;
+    }
+}
+
+void ProfilerPanel::drawFrameBars(const FrameProfiler& profiler, float scale_ms) {
+    const int count = profiler.frameCount();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+    ImVec2 canvas_size = ImVec2(ImGui::GetContentRegionAvail().x, 90.0f);
+    ImGui::InvisibleButton("##FrameBars", canvas_size);
+
+    draw_list->AddRectFilled(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y),
+                             IM_COL32(20, 20, 20, 255));
+
+    // Worst frames in the window get a marker
+    int worst[kWorstMarkers];
+    int worst_count = 0;
+    for (int i = 0; i < count; i++) {
+        float total = profiler.frame(i).total_ms;
+        if (worst_count < kWorstMarkers) {
+            worst[worst_count++] = i;
+        } else if (total > profiler.frame(worst[kWorstMarkers - 1]).total_ms) {
+            worst[kWorstMarkers - 1] = i;
+        } else {
+            continue;
+        }
+        // Keep the list sorted slowest-first
+        for (int s = worst_count - 1; s > 0 && profiler.frame(worst[s]).total_ms > profiler.frame(worst[s - 1]).total_ms; s--) {
+            std::swap(worst[s], worst[s - 1]);
+        }
+    }
+
+    const float bar_width = canvas_size.x / FrameProfiler::kHistory;
+    const float bottom = canvas_pos.y + canvas_size.y;
+    for (int i = 0; i < count; i++) {
+        const FrameRecord& record = profiler.frame(i);
+        // Newest frame at the right edge
+        float x0 = canvas_pos.x + (FrameProfiler::kHistory - count + i) * bar_width;
+        float x1 = x0 + std::max(bar_width - 1.0f, 1.0f);
+        float h = std::min(record.total_ms / scale_ms, 1.0f) * canvas_size.y;
+
+        ImU32 col = record.total_ms > budget_ms_ ? IM_COL32(255, 170, 0, 255) : IM_COL32(70, 180, 90, 255);
+        for (int w = 0; w < worst_count; w++) {
+            if (worst[w] == i) {
+                col = IM_COL32(255, 60, 60, 255);
+                draw_list->AddTriangleFilled(ImVec2(x0 - 3.0f, canvas_pos.y), ImVec2(x1 + 3.0f, canvas_pos.y),
+                                             ImVec2((x0 + x1) * 0.5f, canvas_pos.y + 6.0f), col);
+                break;
+            }
+        }
+        draw_list->AddRectFilled(ImVec2(x0, bottom - h), ImVec2(x1, bottom), col);
+    }
+
+    // Frame budget line
+    float budget_y = bottom - std::min(budget_ms_ / scale_ms, 1.0f) * canvas_size.y;
+    draw_list->AddLine(ImVec2(canvas_pos.x, budget_y), ImVec2(canvas_pos.x + canvas_size.x, budget_y),
+                       IM_COL32(200, 200, 200, 120));
+
+    // Per-frame breakdown on hover
+    if (ImGui::IsItemHovered() && count > 0) {
+        int slot = static_cast<int>((ImGui::GetIO().MousePos.x - canvas_pos.x) / bar_width);
+        int i = slot - (FrameProfiler::kHistory - count);
+        if (i >= 0 && i < count) {
+            const FrameRecord& record = profiler.frame(i);
+            ImGui::BeginTooltip();
+            ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(record.frame_index), record.total_ms);
+            for (int p = 0; p < kPhaseCount; p++) {
+                ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(kPhaseColors[p]), "%-12s %.3f ms",
+                                   profilePhaseName(static_cast<ProfilePhase>(p)), record.phase_ms[p]);
+            }
+            ImGui::EndTooltip();
+        }
+    }
+
+    // Worst frames list
+    for (int w = 0; w < worst_count; w++) {
+        const FrameRecord& record = profiler.frame(worst[w]);
+        int slowest_phase = 0;
+        for (int p = 1; p < kPhaseCount; p++) {
+            if (record.phase_ms[p] > record.phase_ms[slowest_phase]) {
+                slowest_phase = p;
+            }
+        }
+        ImGui::Text("#%llu  %.2f ms  (%s %.2f ms)", static_cast<unsigned long long>(record.frame_index),
+                    record.total_ms, profilePhaseName(static_cast<ProfilePhase>(slowest_phase)),
+                    record.phase_ms[slowest_phase]);
+    }
+}
+
+void ProfilerPanel::draw(const FrameProfiler& profiler) {
+    auto build_start = std::chrono::steady_clock::now();
+
+    ImGui::SetNextWindowPos(ImVec2(640, 610), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(600, 520), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Profiler")) {
+        const int count = profiler.frameCount();
+
+        // Per-phase averages and maxima over the rolling window
+        float avg[kPhaseCount] = {};
+        float max[kPhaseCount] = {};
+        float total_avg = 0.0f;
+        float total_max = 0.0f;
+        for (int i = 0; i < count; i++) {
+            const FrameRecord& record = profiler.frame(i);
+            for (int p = 0; p < kPhaseCount; p++) {
+                avg[p] += record.phase_ms[p];
+                max[p] = std::max(max[p], record.phase_ms[p]);
+            }
+            total_avg += record.total_ms;
+            total_max = std::max(total_max, record.total_ms);
+        }
+        if (count > 0) {
+            for (float& value : avg) value /= count;
+            total_avg /= count;
+        }
+
+        ImGui::TextColored(ImVec4(0.2f, 0.8f, 1.0f, 1.0f), "FRAME TIME");
+        if (count > 0) {
+            const FrameRecord& last = profiler.frame(count - 1);
+            ImGui::Text("Last %.2f ms | Avg %.2f ms | Window worst %.2f ms | All-time worst %.2f ms (#%llu)",
+                        last.total_ms, total_avg, total_max, profiler.worstFrame().total_ms,
+                        static_cast<unsigned long long>(profiler.worstFrame().frame_index));
+        }
+
+        if (ImGui::BeginTable("Phases", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Phase");
+            ImGui::TableSetupColumn("Last ms");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("Max ms");
+            ImGui::TableHeadersRow();
+            for (int p = 0; p < kPhaseCount; p++) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(kPhaseColors[p]), "%s", profilePhaseName(static_cast<ProfilePhase>(p)));
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", count > 0 ? profiler.frame(count - 1).phase_ms[p] : 0.0f);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", avg[p]);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", max[p]);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::Spacing();
+        ImGui::Text("Frames (last %d, budget line %.1f ms, worst %d marked)", FrameProfiler::kHistory, budget_ms_, kWorstMarkers);
+        drawFrameBars(profiler, std::max(total_max, budget_ms_ * 1.5f));
+
+        ImGui::Spacing();
+        float physics_ms[FrameProfiler::kPhysicsHistory];
+        float physics_max = 0.0f;
+        const int physics_count = profiler.physicsCount();
+        for (int i = 0; i < physics_count; i++) {
+            physics_ms[i] = profiler.physicsStepMs(i);
+            physics_max = std::max(physics_max, physics_ms[i]);
+        }
+        ImGui::Text("Physics steps (last %d, max %.3f ms)", physics_count, physics_max);
+        if (physics_count > 0) {
+            ImGui::PlotHistogram("##PhysicsSteps", physics_ms, physics_count, 0, nullptr, 0.0f,
+                                 std::max(physics_max, 0.001f), ImVec2(-1, 60));
+        }
+
+        ImGui::Spacing();
+        ImGui::Text("Draw lists: %d vertices, %d indices", total_vtx_, total_idx_);
+        if (ImGui::BeginTable("DrawLists", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Window");
+            ImGui::TableSetupColumn("Vertices");
+            ImGui::TableSetupColumn("Indices");
+            ImGui::TableSetupColumn("Commands");
+            ImGui::TableHeadersRow();
+            for (const DrawListStats& stats : draw_lists_) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s", stats.owner);
+                ImGui::TableNextColumn(); ImGui::Text("%d", stats.vtx_count);
+                ImGui::TableNextColumn(); ImGui::Text("%d", stats.idx_count);
+                ImGui::TableNextColumn(); ImGui::Text("%d", stats.cmd_count);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::TextDisabled("Panel build: %.3f ms", panel_build_ms_);
+    }
+    ImGui::End();
+
+    panel_build_ms_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+}
+
+} // namespace ev_sim
+
+#endif // EV_SIM_PROFILER
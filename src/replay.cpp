@@ -0,0 +1,196 @@
+#include "replay.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ev_sim {
+
+namespace {
+
+/**
+ * Turns step end points into samples on a fixed grid
+ */
+class Resampler {
+public:
+    Resampler(double grid_dt, std::vector<TelemetrySample>* out)
+        : grid_dt_(grid_dt), next_index_(0), previous_(), out_(out) {}
+
+    /**
+     * Start of the run, or end of a step; rows for every grid point in
+     * (previous time, sample.time] are interpolated from the two points
+     */
+    void add(const TelemetrySample& sample) {
+        if (!out_) {
+            return;
+        }
+        if (next_index_ == 0) {
+            out_->push_back(sample);
+            next_index_ = 1;
+            previous_ = sample;
+            return;
+        }
+        for (;;) {
+            const double grid_time = next_index_ * grid_dt_;
+            // Tolerate the rounding of accumulated step times
+            if (grid_time > sample.time + 1e-9) {
+                break;
+            }
+            const double span = sample.time - previous_.time;
+            const float w = span > 0.0 ? static_cast<float>((grid_time - previous_.time) / span) : 1.0f;
+            TelemetrySample row = sample;    // Inputs and clutch state held over the step
+            row.time = grid_time;
+            row.engine_rpm = previous_.engine_rpm + w * (sample.engine_rpm - previous_.engine_rpm);
+            row.transmission_rpm = previous_.transmission_rpm + w * (sample.transmission_rpm - previous_.transmission_rpm);
+            row.output_rpm = previous_.output_rpm + w * (sample.output_rpm - previous_.output_rpm);
+            row.speed_kmh = previous_.speed_kmh + w * (sample.speed_kmh - previous_.speed_kmh);
+            out_->push_back(row);
+            next_index_++;
+        }
+        previous_ = sample;
+    }
+
+private:
+    double grid_dt_;
+    long next_index_;
+    TelemetrySample previous_;
+    std::vector<TelemetrySample>* out_;
+};
+
+TelemetrySample capture(const Drivetrain& drivetrain, double time, const InputSample& input) {
+    TelemetrySample sample;
+    sample.time = time;
+    sample.engine_rpm = drivetrain.getEngineRPM();
+    sample.transmission_rpm = drivetrain.getTransmissionRPM();
+    sample.output_rpm = drivetrain.getOutputRPM();
+    sample.gear = drivetrain.getGearbox().getGear();
+    sample.speed_kmh = drivetrain.getVehicle().getSpeedKmh();
+    sample.clutch_engagement = drivetrain.getClutchEngagement();
+    sample.clutch_torque = drivetrain.getClutch().calculateClutchTorque();
+    sample.throttle_percent = input.throttle_percent;
+    sample.clutch_pedal_percent = input.clutch_pedal_percent;
+    return sample;
+}
+
+} // namespace
+
+const char* stepModeName(StepMode mode) {
+    switch (mode) {
+        case StepMode::Fixed:    return "fixed";
+        case StepMode::Adaptive: return "adaptive";
+        default:                 return "unknown";
+    }
+}
+
+StepCounts replay(Drivetrain& drivetrain, const InputTrace& trace, const ReplayOptions& options,
+                  std::vector<TelemetrySample>* telemetry) {
+    EV_SIM_TRACE_ZONE("replay", "batch");
+
+    StepCounts counts;
+    if (trace.empty()) {
+        return counts;
+    }
+
+    const double end_time = trace.duration();
+    const double fixed_dt = std::max(options.dt, 1e-6);
+    AdaptiveStepper stepper(options.adaptive);
+    SteadyStateDetector detector(options.fast_forward);
+    const double grid_dt = std::max(options.grid_dt, 1e-6);
+    StepCounts jumps;
+    Resampler resampler(grid_dt, telemetry);
+    resampler.add(capture(drivetrain, 0.0, trace.sampleAt(0.0)));
+
+    double time = 0.0;
+    for (size_t i = 0; i < trace.size() && time < end_time; i++) {
+        const InputSample& input = trace.sample(i);
+        const double segment_end = i + 1 < trace.size() ? std::min(trace.sample(i + 1).time, end_time) : end_time;
+        drivetrain.getGearbox().requestGear(input.gear);
+        detector.reset();
+
+        while (segment_end - time > 1e-9) {
+            double dt;
+            if (options.mode == StepMode::Adaptive) {
+                dt = stepper.step(drivetrain, input.throttle_percent, input.clutch_pedal_percent, segment_end - time);
+            } else {
+                dt = std::min(fixed_dt, segment_end - time);
+                drivetrain.step(input.throttle_percent, input.clutch_pedal_percent, static_cast<float>(dt));
+                counts.accepted++;
+                counts.evaluations++;
+                counts.min_dt = counts.accepted == 1 ? dt : std::min(counts.min_dt, dt);
+                counts.max_dt = std::max(counts.max_dt, dt);
+            }
+            time += dt;
+            resampler.add(capture(drivetrain, time, input));
+
+            if (segment_end - time > dt && detector.observe(drivetrain, dt)) {
+                EV_SIM_TRACE_ZONE("replay::fastForward", "batch");
+
+                // Rows inside the jump from the closed form, then the segment end
+                const Drivetrain start = drivetrain;
+                for (double k = std::floor(time / grid_dt) + 1.0; k * grid_dt < segment_end; k++) {
+                    const double grid_time = k * grid_dt;
+                    drivetrain = start;
+                    SteadyStateDetector::fastForward(drivetrain, grid_time - time, dt);
+                    resampler.add(capture(drivetrain, grid_time, input));
+                }
+                drivetrain = start;
+                SteadyStateDetector::fastForward(drivetrain, segment_end - time, dt);
+
+                jumps.fast_forwards++;
+                jumps.fast_forward_seconds += segment_end - time;
+                jumps.fast_forward_bound = std::max(jumps.fast_forward_bound, detector.errorBound());
+                time = segment_end;
+                resampler.add(capture(drivetrain, time, input));
+            }
+        }
+        time = segment_end;    // Land exactly on the breakpoint
+    }
+
+    if (options.mode == StepMode::Adaptive) {
+        counts = stepper.counts();
+    }
+    counts.fast_forwards = jumps.fast_forwards;
+    counts.fast_forward_seconds = jumps.fast_forward_seconds;
+    counts.fast_forward_bound = jumps.fast_forward_bound;
+    return counts;
+}
+
+StepCounts driveCycle(Drivetrain& drivetrain, DriverModel& driver, const DriveCycle& cycle,
+                      const ReplayOptions& options, std::vector<TelemetrySample>* telemetry) {
+    EV_SIM_TRACE_ZONE("driveCycle", "batch");
+
+    StepCounts counts;
+    const double dt = std::max(options.dt, 1e-6);
+    const uint64_t steps = static_cast<uint64_t>(std::ceil(cycle.duration() / dt - 1e-9));
+    Resampler resampler(std::max(options.grid_dt, 1e-6), telemetry);
+    InputSample input = { 0.0, 0.0f, 100.0f, 0 };
+    resampler.add(capture(drivetrain, 0.0, input));
+
+    size_t cursor = 0;
+    for (uint64_t i = 0; i < steps; i++) {
+        const double time = (i + 1) * dt;
+        const DriverCommand command = driver.step(drivetrain, cycle.speedAt(time, cursor), static_cast<float>(dt));
+        input.throttle_percent = command.throttle_percent;
+        input.clutch_pedal_percent = command.clutch_pedal_percent;
+        resampler.add(capture(drivetrain, time, input));
+    }
+    counts.accepted = steps;
+    counts.evaluations = steps;
+    counts.min_dt = steps > 0 ? dt : 0.0;
+    counts.max_dt = counts.min_dt;
+    return counts;
+}
+
+void writeTelemetryCsv(std::ostream& out, const std::vector<TelemetrySample>& telemetry) {
+    out << "time,engine_rpm,transmission_rpm,clutch_engagement,clutch_torque,throttle,clutch,gear,output_rpm,speed_kmh\n";
+    char line[240];
+    for (const TelemetrySample& sample : telemetry) {
+        std::snprintf(line, sizeof(line), "%.4f,%.2f,%.2f,%.4f,%.3f,%.2f,%.2f,%d,%.2f,%.2f\n", sample.time, sample.engine_rpm,
+                      sample.transmission_rpm, sample.clutch_engagement, sample.clutch_torque,
+                      sample.throttle_percent, sample.clutch_pedal_percent, sample.gear, sample.output_rpm,
+                      sample.speed_kmh);
+        out << line;
+    }
+}
+
+} // namespace ev_sim
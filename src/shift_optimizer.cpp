@@ -0,0 +1,349 @@
+#include "shift_optimizer.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <random>
+
+namespace ev_sim {
+
+namespace {
+
+using GridPoint = std::vector<int>;    // Grid index per search variable
+
+constexpr double kChebyshevRho = 0.05;      // Weight of the summed term; keeps weakly dominated points off the front
+constexpr double kInfeasiblePenalty = 10.0; // Above any normalized feasible score
+constexpr double kInitialStep = 0.2;        // Nelder-Mead simplex edge in the unit cube
+
+/**
+ * Simulated schedules, shared by every search
+ *
+ * The first request for a point inserts a future and simulates outside the
+ * lock; later requests, from any thread, wait on that future.
+ */
+class EvaluationCache {
+public:
+    template <typename Simulate>
+    ShiftCandidate get(const GridPoint& point, Simulate&& simulate) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        requests_++;
+        auto found = entries_.find(point);
+        if (found != entries_.end()) {
+            std::shared_future<ShiftCandidate> result = found->second;
+            lock.unlock();
+            return result.get();
+        }
+        std::promise<ShiftCandidate> promise;
+        entries_.emplace(point, promise.get_future().share());
+        lock.unlock();
+
+        const ShiftCandidate candidate = simulate(point);
+        promise.set_value(candidate);
+        return candidate;
+    }
+
+    size_t requests() const { return requests_; }
+    size_t size() const { return entries_.size(); }
+
+    /**
+     * Every simulated candidate in grid order; call once the searches are done
+     */
+    std::vector<ShiftCandidate> candidates() const {
+        std::vector<ShiftCandidate> out;
+        out.reserve(entries_.size());
+        for (const auto& entry : entries_) {
+            out.push_back(entry.second.get());
+        }
+        return out;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<GridPoint, std::shared_future<ShiftCandidate>> entries_;
+    size_t requests_ = 0;
+};
+
+/**
+ * Maps both objectives to roughly [0, 1] over the initial samples and
+ * scores candidates for one time/energy weight
+ */
+class Scalarizer {
+public:
+    explicit Scalarizer(const std::vector<ShiftCandidate>& samples) {
+        ideal_[0] = ideal_[1] = 1e300;
+        double worst[2] = { -1e300, -1e300 };
+        const bool any_feasible = std::any_of(samples.begin(), samples.end(),
+                                              [](const ShiftCandidate& c) { return c.feasible; });
+        for (const ShiftCandidate& c : samples) {
+            if (c.feasible || !any_feasible) {
+                const double f[2] = { c.acceleration_time, c.wh_per_km };
+                for (int i = 0; i < 2; i++) {
+                    ideal_[i] = std::min(ideal_[i], f[i]);
+                    worst[i] = std::max(worst[i], f[i]);
+                }
+            }
+        }
+        for (int i = 0; i < 2; i++) {
+            if (ideal_[i] > worst[i]) {
+                ideal_[i] = worst[i] = 0.0;
+            }
+            inv_range_[i] = 1.0 / std::max(worst[i] - ideal_[i], 1e-9);
+        }
+    }
+
+    /**
+     * @param time_weight Weight of the acceleration time in [0, 1]; energy gets the rest
+     */
+    double score(const ShiftCandidate& c, double time_weight, double max_rms_error) const {
+        if (!c.feasible) {
+            return kInfeasiblePenalty + std::max(c.rms_speed_error - max_rms_error, 0.0) + c.acceleration_time;
+        }
+        const double time = (c.acceleration_time - ideal_[0]) * inv_range_[0];
+        const double energy = (c.wh_per_km - ideal_[1]) * inv_range_[1];
+        return std::max(time_weight * time, (1.0 - time_weight) * energy) + kChebyshevRho * (time + energy);
+    }
+
+private:
+    double ideal_[2];
+    double inv_range_[2];
+};
+
+} // namespace
+
+ShiftOptimizer::ShiftOptimizer(const CycleConfig& base, const std::vector<DriveCycle>& cycles,
+                               const ShiftOptimizerOptions& options)
+    : base_(base)
+    , cycles_(cycles)
+    , options_(options)
+    , dimensions_(std::clamp(base.gearbox.gear_count, 1, GearboxParameters::kMaxGears) - 1 + 2)
+{
+}
+
+ShiftOptimizerResult ShiftOptimizer::run(ThreadPool& pool) {
+    EV_SIM_TRACE_ZONE("ShiftOptimizer::run", "batch");
+
+    const ShiftSearchSpace& space = options_.space;
+    const int upshifts = dimensions_ - 2;
+
+    // Per variable: lowest value, grid step and number of steps to the highest
+    std::vector<float> lows(dimensions_);
+    std::vector<float> steps(dimensions_);
+    std::vector<int> levels(dimensions_);
+    auto setVariable = [&](int i, float low, float high, float step) {
+        lows[i] = low;
+        steps[i] = std::max(step, 1e-6f);
+        levels[i] = std::max(static_cast<int>(std::lround((high - low) / steps[i])), 1);
+    };
+    for (int i = 0; i < upshifts; i++) {
+        setVariable(i, space.min_upshift_rpm, space.max_upshift_rpm, space.rpm_step);
+    }
+    setVariable(upshifts, space.min_launch_time, space.max_launch_time, space.time_step);
+    setVariable(upshifts + 1, space.min_release_time, space.max_release_time, space.time_step);
+
+    auto snap = [&](const std::vector<double>& unit) {
+        GridPoint point(dimensions_);
+        for (int i = 0; i < dimensions_; i++) {
+            point[i] = static_cast<int>(std::lround(std::clamp(unit[i], 0.0, 1.0) * levels[i]));
+        }
+        return point;
+    };
+    auto value = [&](const GridPoint& point, int i) { return lows[i] + steps[i] * point[i]; };
+
+    auto simulate = [&](const GridPoint& point) {
+        CycleConfig config = base_;
+        for (int i = 0; i < upshifts; i++) {
+            config.driver.schedule.upshift_rpm[i] = value(point, i);
+        }
+        config.driver.schedule.launch_time = value(point, upshifts);
+        config.driver.schedule.release_time = value(point, upshifts + 1);
+
+        ShiftCandidate candidate;
+        candidate.schedule = config.driver.schedule;
+        const AccelerationResult run = runAcceleration(config, options_.cycle, options_.target_kmh, options_.time_limit);
+        candidate.acceleration_time = run.time;
+
+        double energy = 0.0;
+        double distance = 0.0;
+        for (const DriveCycle& cycle : cycles_) {
+            const CycleResult result = runCycle(cycle, config, options_.cycle);
+            energy += result.battery_energy;
+            distance += result.distance;
+            candidate.rms_speed_error = std::max(candidate.rms_speed_error, result.rms_speed_error);
+        }
+        candidate.wh_per_km = distance > 0.0 ? (energy / 3600.0) / (distance / 1e3) : 0.0;
+        candidate.feasible = run.reached && candidate.rms_speed_error <= options_.max_rms_error;
+        return candidate;
+    };
+
+    EvaluationCache cache;
+
+    // Latin hypercube: one sample per stratum of every variable, plus the
+    // base schedule as a reference
+    std::vector<GridPoint> seeds;
+    {
+        GridPoint base(dimensions_);
+        const ShiftSchedule& schedule = base_.driver.schedule;
+        const float base_values[] = { schedule.launch_time, schedule.release_time };
+        for (int i = 0; i < dimensions_; i++) {
+            const float v = i < upshifts ? schedule.upshift_rpm[i] : base_values[i - upshifts];
+            base[i] = std::clamp(static_cast<int>(std::lround((v - lows[i]) / steps[i])), 0, levels[i]);
+        }
+        seeds.push_back(base);
+    }
+    const int samples = std::max(options_.initial_samples, 1);
+    std::mt19937 rng(options_.seed);
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+    std::vector<std::vector<double>> unit(samples, std::vector<double>(dimensions_));
+    std::vector<int> strata(samples);
+    for (int i = 0; i < dimensions_; i++) {
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), rng);
+        for (int s = 0; s < samples; s++) {
+            unit[s][i] = (strata[s] + jitter(rng)) / samples;
+        }
+    }
+    for (const std::vector<double>& u : unit) {
+        seeds.push_back(snap(u));
+    }
+
+    std::vector<ShiftCandidate> seed_results(seeds.size());
+    pool.parallelFor(seeds.size(), [&](size_t index) { seed_results[index] = cache.get(seeds[index], simulate); });
+    const Scalarizer scalarizer(seed_results);
+
+    // One Nelder-Mead search per weight in the unit cube, starting from the
+    // best seed for that weight; points are snapped to the grid to evaluate
+    const int weights = std::max(options_.weights, 1);
+    pool.parallelFor(static_cast<size_t>(weights), [&](size_t index) {
+        const double time_weight = weights > 1 ? static_cast<double>(index) / (weights - 1) : 0.5;
+        int budget = options_.evaluations_per_weight;
+        auto objective = [&](const std::vector<double>& x) {
+            budget--;
+            return scalarizer.score(cache.get(snap(x), simulate), time_weight, options_.max_rms_error);
+        };
+
+        size_t best_seed = 0;
+        double best_score = 1e300;
+        for (size_t s = 0; s < seeds.size(); s++) {
+            const double score = scalarizer.score(seed_results[s], time_weight, options_.max_rms_error);
+            if (score < best_score) {
+                best_score = score;
+                best_seed = s;
+            }
+        }
+
+        const int n = dimensions_;
+        std::vector<std::vector<double>> simplex(n + 1, std::vector<double>(n));
+        std::vector<double> scores(n + 1);
+        for (int i = 0; i < n; i++) {
+            simplex[0][i] = static_cast<double>(seeds[best_seed][i]) / levels[i];
+        }
+        scores[0] = best_score;
+        for (int v = 1; v <= n; v++) {
+            simplex[v] = simplex[0];
+            double& x = simplex[v][v - 1];
+            x = x + kInitialStep <= 1.0 ? x + kInitialStep : x - kInitialStep;
+            scores[v] = objective(simplex[v]);
+        }
+
+        std::vector<int> order(n + 1);
+        std::vector<double> centroid(n);
+        auto along = [&](const std::vector<double>& from, double t) {
+            // centroid + t * (centroid - from), kept inside the cube
+            std::vector<double> x(n);
+            for (int i = 0; i < n; i++) {
+                x[i] = std::clamp(centroid[i] + t * (centroid[i] - from[i]), 0.0, 1.0);
+            }
+            return x;
+        };
+        while (budget > 0) {
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](int a, int b) { return scores[a] < scores[b]; });
+            const int best = order[0];
+            const int worst = order[n];
+            const int second_worst = order[n - 1];
+
+            // Converged once every vertex snaps to the same grid point
+            const GridPoint best_point = snap(simplex[best]);
+            if (std::all_of(simplex.begin(), simplex.end(),
+                            [&](const std::vector<double>& x) { return snap(x) == best_point; })) {
+                break;
+            }
+
+            std::fill(centroid.begin(), centroid.end(), 0.0);
+            for (int v = 0; v <= n; v++) {
+                if (v != worst) {
+                    for (int i = 0; i < n; i++) {
+                        centroid[i] += simplex[v][i] / n;
+                    }
+                }
+            }
+
+            const std::vector<double> reflected = along(simplex[worst], 1.0);
+            const double reflected_score = objective(reflected);
+            if (reflected_score < scores[best]) {
+                const std::vector<double> expanded = along(simplex[worst], 2.0);
+                const double expanded_score = objective(expanded);
+                const bool expand = expanded_score < reflected_score;
+                simplex[worst] = expand ? expanded : reflected;
+                scores[worst] = expand ? expanded_score : reflected_score;
+            } else if (reflected_score < scores[second_worst]) {
+                simplex[worst] = reflected;
+                scores[worst] = reflected_score;
+            } else {
+                const bool outside = reflected_score < scores[worst];
+                const std::vector<double> contracted = along(simplex[worst], outside ? 0.5 : -0.5);
+                const double contracted_score = objective(contracted);
+                if (contracted_score < std::min(reflected_score, scores[worst])) {
+                    simplex[worst] = contracted;
+                    scores[worst] = contracted_score;
+                } else {
+                    // Shrink towards the best vertex
+                    for (int v = 0; v <= n && budget > 0; v++) {
+                        if (v != best) {
+                            for (int i = 0; i < n; i++) {
+                                simplex[v][i] = 0.5 * (simplex[v][i] + simplex[best][i]);
+                            }
+                            scores[v] = objective(simplex[v]);
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    ShiftOptimizerResult result;
+    result.baseline = seed_results[0];
+    result.evaluated = cache.candidates();
+    result.front = paretoFront(result.evaluated);
+    result.evaluations = cache.requests();
+    result.simulations = cache.size();
+    result.cache_hits = result.evaluations - result.simulations;
+    return result;
+}
+
+std::vector<ShiftCandidate> paretoFront(const std::vector<ShiftCandidate>& candidates) {
+    std::vector<const ShiftCandidate*> feasible;
+    for (const ShiftCandidate& c : candidates) {
+        if (c.feasible) {
+            feasible.push_back(&c);
+        }
+    }
+    // Fastest first (then cheapest); a point is on the front if it beats the
+    // cheapest energy of everything faster
+    std::stable_sort(feasible.begin(), feasible.end(), [](const ShiftCandidate* a, const ShiftCandidate* b) {
+        return a->acceleration_time != b->acceleration_time ? a->acceleration_time < b->acceleration_time
+                                                            : a->wh_per_km < b->wh_per_km;
+    });
+    std::vector<ShiftCandidate> front;
+    for (const ShiftCandidate* c : feasible) {
+        if (front.empty() || c->wh_per_km < front.back().wh_per_km) {
+            front.push_back(*c);
+        }
+    }
+    return front;
+}
+
+} // namespace ev_sim
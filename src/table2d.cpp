@@ -0,0 +1,200 @@
+#include "table2d.hpp"
+#include "trace.hpp"
+#include <cassert>
+#include <limits>
+
+// MSVC has no __FMA__; /arch:AVX2 implies FMA there
+#if defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+#define EV_SIM_TABLE_AVX2 1
+#else
+#define EV_SIM_TABLE_AVX2 0
+#endif
+
+namespace ev_sim {
+
+namespace {
+
+constexpr int kLookupBlock = 64;   // Points located per pass; the scratch stays in L1
+
+} // namespace
+
+TableAxis::TableAxis(float first, float last, int points)
+    : cells_(std::max(points, 2) - 1)
+    , search_step_(0)
+    , uniform_(true)
+    , first_(first)
+    , scale_(cells_ / std::max(last - first, 1e-12f))
+    , last_cell_(static_cast<float>(cells_))
+{
+    for (int i = 0; i <= cells_; i++) {
+        breakpoints_.push_back(first + (last - first) * i / cells_);
+    }
+    buildSearch();
+}
+
+TableAxis::TableAxis(const std::vector<float>& breakpoints)
+    : breakpoints_(breakpoints)
+    , cells_(0)
+    , search_step_(0)
+    , uniform_(false)
+    , first_(0.0f)
+    , scale_(0.0f)
+    , last_cell_(0.0f)
+{
+    assert(breakpoints.size() >= 2);
+    assert(std::is_sorted(breakpoints.begin(), breakpoints.end()));
+    while (breakpoints_.size() < 2) {
+        breakpoints_.push_back(breakpoints_.empty() ? 0.0f : breakpoints_.back() + 1.0f);
+    }
+    cells_ = static_cast<int>(breakpoints_.size()) - 1;
+    first_ = breakpoints_.front();
+    last_cell_ = static_cast<float>(cells_);
+    buildSearch();
+}
+
+void TableAxis::buildSearch() {
+    inv_width_.resize(cells_);
+    for (int i = 0; i < cells_; i++) {
+        const float width = breakpoints_[i + 1] - breakpoints_[i];
+        inv_width_[i] = width > 0.0f ? 1.0f / width : 0.0f;
+    }
+
+    // Steps s, s/2, ..., 1 reach any cell up to 2s - 1 >= cells_, probing
+    // indices up to 2s - 1; breakpoints past the last compare as never reached
+    search_step_ = 1;
+    while (2 * search_step_ - 1 < cells_) {
+        search_step_ *= 2;
+    }
+    breakpoints_.resize(2 * search_step_, std::numeric_limits<float>::max());
+}
+
+void TableAxis::locate(const float* x, int* cell, float* weight, int count) const {
+    if (!uniform_) {
+        int i = 0;
+#if EV_SIM_TABLE_AVX2
+        // The binary search eight lanes at a time, probing with gathers. Each
+        // step sweeps all lanes before the next, so the gathers of different
+        // lanes overlap; weight holds the clamped coordinate until the end
+        const int vector_count = count / 8 * 8;
+        const __m256 first = _mm256_set1_ps(first_);
+        const __m256 last = _mm256_set1_ps(breakpoints_[cells_]);
+        for (i = 0; i < vector_count; i += 8) {
+            _mm256_storeu_ps(weight + i, _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(x + i), first), last));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(cell + i), _mm256_setzero_si256());
+        }
+        for (int step = search_step_; step > 0; step >>= 1) {
+            const __m256i step8 = _mm256_set1_epi32(step);
+            for (i = 0; i < vector_count; i += 8) {
+                __m256i* lane_cell = reinterpret_cast<__m256i*>(cell + i);
+                const __m256i index = _mm256_loadu_si256(lane_cell);
+                const __m256 probe = _mm256_i32gather_ps(breakpoints_.data(), _mm256_add_epi32(index, step8), 4);
+                const __m256 above = _mm256_cmp_ps(_mm256_loadu_ps(weight + i), probe, _CMP_GE_OQ);
+                _mm256_storeu_si256(lane_cell, _mm256_add_epi32(index, _mm256_and_si256(_mm256_castps_si256(above), step8)));
+            }
+        }
+        const __m256i max_cell = _mm256_set1_epi32(cells_ - 1);
+        for (i = 0; i < vector_count; i += 8) {
+            __m256i* lane_cell = reinterpret_cast<__m256i*>(cell + i);
+            const __m256i index = _mm256_min_epi32(_mm256_loadu_si256(lane_cell), max_cell);
+            const __m256 base = _mm256_i32gather_ps(breakpoints_.data(), index, 4);
+            const __m256 inv_width = _mm256_i32gather_ps(inv_width_.data(), index, 4);
+            _mm256_storeu_si256(lane_cell, index);
+            _mm256_storeu_ps(weight + i, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(weight + i), base), inv_width));
+        }
+#endif
+        for (; i < count; i++) {
+            cell[i] = locate(x[i], weight[i]);
+        }
+        return;
+    }
+    const float first = first_;
+    const float scale = scale_;
+    const float last_cell = last_cell_;
+    const int max_cell = cells_ - 1;
+    for (int i = 0; i < count; i++) {
+        const float u = std::min(last_cell, std::max(0.0f, (x[i] - first) * scale));
+        const int index = std::min(static_cast<int>(u), max_cell);
+        cell[i] = index;
+        weight[i] = u - static_cast<float>(index);
+    }
+}
+
+Table2D::Table2D()
+    : Table2D(TableAxis(0.0f, 1.0f, 2), TableAxis(0.0f, 1.0f, 2), std::vector<float>(4, 0.0f))
+{
+}
+
+Table2D::Table2D(const TableAxis& x, const TableAxis& y, const std::vector<float>& values)
+    : x_(x)
+    , y_(y)
+{
+    assert(values.size() == static_cast<size_t>(x.size()) * y.size());
+    const int columns = y_.size();
+    auto value = [&](int i, int j) {
+        const size_t index = static_cast<size_t>(i) * columns + j;
+        return index < values.size() ? values[index] : 0.0f;
+    };
+    cells_.resize(static_cast<size_t>(x_.cells()) * y_.cells() * 4);
+    for (int i = 0; i < x_.cells(); i++) {
+        for (int j = 0; j < y_.cells(); j++) {
+            float* cell = cells_.data() + 4 * (i * y_.cells() + j);
+            cell[0] = value(i, j);
+            cell[1] = value(i, j + 1);
+            cell[2] = value(i + 1, j);
+            cell[3] = value(i + 1, j + 1);
+        }
+    }
+}
+
+float Table2D::at(int row, int column) const {
+    // Edge breakpoints are the upper corners of the last cell
+    const int i = std::min(row, x_.cells() - 1);
+    const int j = std::min(column, y_.cells() - 1);
+    const int corner = (row > i ? 2 : 0) + (column > j ? 1 : 0);
+    return cells_[4 * (i * y_.cells() + j) + corner];
+}
+
+void Table2D::lookup(const float* x, const float* y, float* out, int count) const {
+    EV_SIM_TRACE_ZONE("Table2D::lookup", "physics");
+
+    alignas(32) int rows[kLookupBlock];
+    alignas(32) int columns[kLookupBlock];
+    alignas(32) float wx[kLookupBlock];
+    alignas(32) float wy[kLookupBlock];
+    const int row_cells = y_.cells();
+    const float* cells = cells_.data();
+
+    for (int start = 0; start < count; start += kLookupBlock) {
+        const int n = std::min(kLookupBlock, count - start);
+
+        // Pass 1: cells and weights, one axis at a time
+        x_.locate(x + start, rows, wx, n);
+        y_.locate(y + start, columns, wy, n);
+        for (int i = 0; i < n; i++) {
+            rows[i] = 4 * (rows[i] * row_cells + columns[i]);   // Float offset of the cell
+        }
+
+        // Pass 2: fetch each cell's corners and blend
+        int i = 0;
+#if EV_SIM_TABLE_AVX2
+        for (; i + 8 <= n; i += 8) {
+            const __m256i offset = _mm256_load_si256(reinterpret_cast<const __m256i*>(rows + i));
+            const __m256 v00 = _mm256_i32gather_ps(cells, offset, 4);
+            const __m256 v01 = _mm256_i32gather_ps(cells + 1, offset, 4);
+            const __m256 v10 = _mm256_i32gather_ps(cells + 2, offset, 4);
+            const __m256 v11 = _mm256_i32gather_ps(cells + 3, offset, 4);
+            const __m256 wx8 = _mm256_load_ps(wx + i);
+            const __m256 wy8 = _mm256_load_ps(wy + i);
+            const __m256 low = _mm256_fmadd_ps(_mm256_sub_ps(v01, v00), wy8, v00);
+            const __m256 high = _mm256_fmadd_ps(_mm256_sub_ps(v11, v10), wy8, v10);
+            _mm256_storeu_ps(out + start + i, _mm256_fmadd_ps(_mm256_sub_ps(high, low), wx8, low));
+        }
+#endif
+        for (; i < n; i++) {
+            out[start + i] = blend(cells + rows[i], wx[i], wy[i]);
+        }
+    }
+}
+
+} // namespace ev_sim
@@ -0,0 +1,71 @@
+#include "thermal_model.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+ThermalModel::ThermalModel(const ThermalParameters& params)
+    : params_(params)
+    , temperature_(params.initial_c)
+    , heat_input_w_(0.0f)
+    , pending_energy_(0.0f)
+{
+}
+
+void ThermalModel::update(float dt) {
+    EV_SIM_TRACE_ZONE("ThermalModel::update", "physics");
+
+    if (dt <= 0.0f) {
+        return;
+    }
+    heat_input_w_ = pending_energy_ / dt;
+    pending_energy_ = 0.0f;
+
+    const float capacity = std::max(params_.heat_capacity, 1.0f);
+    const float base = std::max(params_.base_conductance, 1e-3f);
+    const float radiator = std::max(params_.radiator_conductance, 0.0f);
+
+    // At most one thermostat crossing: the equilibrium of the new regime
+    // lies on the same side as the one being approached
+    float remaining = dt;
+    for (int regime_change = 0; regime_change < 2 && remaining > 0.0f; regime_change++) {
+        const bool radiator_open = temperature_ > params_.thermostat_c ||
+                                   (temperature_ == params_.thermostat_c &&
+                                    heat_input_w_ > base * (params_.thermostat_c - params_.ambient_c));
+
+        // Net heat flow is linear in T on each side: C dT/dt = Q0 - G * T
+        const float conductance = radiator_open ? base + radiator : base;
+        const float q0 = heat_input_w_ + base * params_.ambient_c +
+                         (radiator_open ? radiator * params_.thermostat_c : 0.0f);
+        const float equilibrium = q0 / conductance;
+        const float rate = conductance / capacity;
+
+        // Does the trajectory reach the thermostat inside this interval?
+        const bool crosses = radiator_open ? equilibrium < params_.thermostat_c
+                                           : equilibrium > params_.thermostat_c;
+        if (crosses && temperature_ != params_.thermostat_c) {
+            const float t_cross = -std::log((params_.thermostat_c - equilibrium) /
+                                            (temperature_ - equilibrium)) / rate;
+            if (t_cross < remaining) {
+                temperature_ = params_.thermostat_c;
+                remaining -= t_cross;
+                continue;
+            }
+        }
+
+        temperature_ = equilibrium + (temperature_ - equilibrium) * std::exp(-rate * remaining);
+        remaining = 0.0f;
+    }
+}
+
+float ThermalModel::getTorqueDerate() const {
+    const float span = params_.derate_end_c - params_.derate_start_c;
+    if (span <= 0.0f) {
+        return temperature_ < params_.derate_start_c ? 1.0f : params_.min_derate;
+    }
+    const float over = std::clamp((temperature_ - params_.derate_start_c) / span, 0.0f, 1.0f);
+    return 1.0f - over * (1.0f - params_.min_derate);
+}
+
+} // namespace ev_sim
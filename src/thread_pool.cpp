@@ -0,0 +1,101 @@
+#include "thread_pool.hpp"
+#include "trace.hpp"
+#include <algorithm>
+
+namespace ev_sim {
+
+ThreadPool::ThreadPool(int threads)
+    : job_(nullptr)
+    , count_(0)
+    , next_(0)
+    , finished_(0)
+    , generation_(0)
+    , busy_(0)
+    , stop_(false)
+{
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+    }
+    for (int i = 1; i < threads; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& job) {
+    EV_SIM_TRACE_ZONE("ThreadPool::parallelFor", "batch");
+
+    if (count == 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &job;
+        count_ = count;
+        next_.store(0);
+        finished_.store(0);
+        generation_++;
+    }
+    wake_.notify_all();
+
+    drain();
+
+    // The batch is over once every index ran and no worker still holds the job
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return finished_.load() == count_ && busy_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::drain() {
+    const std::function<void(size_t)>& job = *job_;
+    for (;;) {
+        const size_t index = next_.fetch_add(1);
+        if (index >= count_) {
+            return;
+        }
+        job(index);
+        finished_.fetch_add(1);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || (job_ && generation_ != seen); });
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            busy_++;
+        }
+
+        drain();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_--;
+        }
+        done_.notify_one();
+    }
+}
+
+} // namespace ev_sim
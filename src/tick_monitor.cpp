@@ -0,0 +1,136 @@
+#include "tick_monitor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ev_sim {
+
+TickScheduler::TickScheduler(double period, int max_catch_up)
+    : period_(period)
+    , max_catch_up_(std::max(max_catch_up, 1))
+    , next_due_(period)
+    , batch_start_(period)
+    , last_dropped_(0)
+{
+}
+
+void TickScheduler::reset(double now) {
+    next_due_ = now + period_;
+    batch_start_ = next_due_;
+    last_dropped_ = 0;
+}
+
+int TickScheduler::poll(double now) {
+    last_dropped_ = 0;
+    if (now < next_due_) {
+        return 0;
+    }
+
+    int due = static_cast<int>(std::floor((now - next_due_) / period_)) + 1;
+    if (due > max_catch_up_) {
+        // Too far behind: skip ahead instead of spiralling
+        last_dropped_ = due - max_catch_up_;
+        next_due_ += last_dropped_ * period_;
+        due = max_catch_up_;
+    }
+
+    batch_start_ = next_due_;
+    next_due_ += due * period_;
+    return due;
+}
+
+TickMonitor::TickMonitor(float bin_ms)
+    : bin_ms_(bin_ms)
+{
+    reset();
+}
+
+void TickMonitor::reset() {
+    head_ = 0;
+    count_ = 0;
+    std::fill(histogram_, histogram_ + kHistogramBins, 0);
+    total_ticks_ = 0;
+    caught_up_ = 0;
+    dropped_ = 0;
+    lateness_sum_ = 0.0;
+    lateness_sq_sum_ = 0.0;
+    max_lateness_ms_ = 0.0f;
+}
+
+void TickMonitor::recordTick(double scheduled, double actual, int batch_size) {
+    TickRecord& record = ticks_[head_];
+    record.scheduled = scheduled;
+    record.actual = actual;
+    record.lateness_ms = static_cast<float>((actual - scheduled) * 1000.0);
+    record.batch_size = batch_size;
+    head_ = (head_ + 1) % kHistory;
+    count_ = std::min(count_ + 1, kHistory);
+
+    const float lateness = std::max(record.lateness_ms, 0.0f);
+    const int bin = std::min(static_cast<int>(lateness / bin_ms_), kHistogramBins - 1);
+    histogram_[bin]++;
+
+    total_ticks_++;
+    caught_up_ += batch_size > 1 ? 1 : 0;
+    lateness_sum_ += lateness;
+    lateness_sq_sum_ += static_cast<double>(lateness) * lateness;
+    max_lateness_ms_ = std::max(max_lateness_ms_, lateness);
+}
+
+void TickMonitor::recordDropped(int count) {
+    dropped_ += static_cast<uint64_t>(std::max(count, 0));
+}
+
+const TickRecord& TickMonitor::tick(int index) const {
+    return ticks_[(head_ - count_ + index + kHistory) % kHistory];
+}
+
+TickStats TickMonitor::stats() const {
+    TickStats stats = {};
+    stats.ticks = total_ticks_;
+    stats.caught_up = caught_up_;
+    stats.dropped = dropped_;
+    stats.max_ms = max_lateness_ms_;
+    if (total_ticks_ == 0) {
+        return stats;
+    }
+
+    const double mean = lateness_sum_ / total_ticks_;
+    stats.mean_ms = static_cast<float>(mean);
+    stats.jitter_ms = static_cast<float>(std::sqrt(std::max(lateness_sq_sum_ / total_ticks_ - mean * mean, 0.0)));
+
+    scratch_.resize(count_);
+    for (int i = 0; i < count_; i++) {
+        scratch_[i] = std::max(tick(i).lateness_ms, 0.0f);
+    }
+    auto percentile = [&](float p) {
+        const size_t k = std::min(static_cast<size_t>(p * count_), scratch_.size() - 1);
+        std::nth_element(scratch_.begin(), scratch_.begin() + k, scratch_.end());
+        return scratch_[k];
+    };
+    stats.p50_ms = percentile(0.50f);
+    stats.p99_ms = percentile(0.99f);
+    return stats;
+}
+
+bool TickMonitor::meetsSla(const TickSla& sla, std::string* violation) const {
+    const TickStats s = stats();
+    char text[128];
+    text[0] = '\0';
+    if (sla.p99_lateness_ms >= 0.0f && s.p99_ms > sla.p99_lateness_ms) {
+        std::snprintf(text, sizeof(text), "p99 lateness %.2f ms > %.2f ms", s.p99_ms, sla.p99_lateness_ms);
+    } else if (sla.max_lateness_ms >= 0.0f && s.max_ms > sla.max_lateness_ms) {
+        std::snprintf(text, sizeof(text), "max lateness %.2f ms > %.2f ms", s.max_ms, sla.max_lateness_ms);
+    } else if (sla.max_dropped >= 0 && s.dropped > static_cast<uint64_t>(sla.max_dropped)) {
+        std::snprintf(text, sizeof(text), "%llu dropped ticks > %lld", static_cast<unsigned long long>(s.dropped),
+                      static_cast<long long>(sla.max_dropped));
+    } else {
+        return true;
+    }
+    if (violation) {
+        *violation = text;
+    }
+    return false;
+}
+
+} // namespace ev_sim
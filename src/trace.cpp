@@ -0,0 +1,162 @@
+#include "trace.hpp"
+
+#if EV_SIM_TRACE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace ev_sim {
+
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+            out << escaped;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+// Microseconds with nanosecond resolution, as trace viewers expect
+void writeMicros(std::ostream& out, int64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                  static_cast<long long>(ns % 1000));
+    out << text;
+}
+
+} // namespace
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : enabled_(false)
+    , epoch_ns_(steadyNowNs())
+{
+}
+
+void TraceRecorder::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t TraceRecorder::now() const {
+    return steadyNowNs() - epoch_ns_;
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::threadBuffer() {
+    // The recorder is a process singleton, so one cached pointer per thread is enough
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        buffers_.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+        buffer = buffers_.back().get();
+        buffer->thread_id = static_cast<uint32_t>(buffers_.size());
+    }
+    return *buffer;
+}
+
+void TraceRecorder::record(const char* name, const char* category, int64_t begin_ns, int64_t end_ns) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.empty()) {
+        buffer.events.resize(kEventsPerThread);
+    }
+    buffer.events[buffer.head] = TraceEvent{ name, category, begin_ns, end_ns };
+    buffer.head = (buffer.head + 1) % kEventsPerThread;
+    buffer.count = std::min(buffer.count + 1, kEventsPerThread);
+}
+
+void TraceRecorder::setThreadName(const char* name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.thread_name = name;
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->head = 0;
+        buffer->count = 0;
+    }
+}
+
+size_t TraceRecorder::writeChromeTrace(std::ostream& out, int64_t begin_ns, int64_t end_ns) const {
+    size_t written = 0;
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        return out;
+    };
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+
+        separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->thread_id
+                    << ", \"args\": {\"name\": ";
+        if (buffer->thread_name.empty()) {
+            writeJsonString(out, ("thread " + std::to_string(buffer->thread_id)).c_str());
+        } else {
+            writeJsonString(out, buffer->thread_name.c_str());
+        }
+        out << "}}";
+
+        // Oldest to newest
+        const size_t start = (buffer->head + kEventsPerThread - buffer->count) % kEventsPerThread;
+        for (size_t i = 0; i < buffer->count; i++) {
+            const TraceEvent& event = buffer->events[(start + i) % kEventsPerThread];
+            if (event.end_ns < begin_ns || event.begin_ns > end_ns) {
+                continue;
+            }
+            separator() << "{\"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"cat\": ";
+            writeJsonString(out, event.category);
+            out << ", \"ph\": \"X\", \"ts\": ";
+            writeMicros(out, event.begin_ns);
+            out << ", \"dur\": ";
+            writeMicros(out, event.end_ns - event.begin_ns);
+            out << ", \"pid\": 1, \"tid\": " << buffer->thread_id << "}";
+            written++;
+        }
+    }
+
+    out << "\n]}\n";
+    return written;
+}
+
+long TraceRecorder::exportChromeTrace(const std::string& path, double window_seconds) const {
+    std::ofstream file(path);
+    if (!file) {
+        return -1;
+    }
+    const int64_t end_ns = now();
+    const int64_t begin_ns = end_ns - static_cast<int64_t>(window_seconds * 1e9);
+    return static_cast<long>(writeChromeTrace(file, begin_ns, end_ns));
+}
+
+} // namespace ev_sim
+
+#endif // EV_SIM_TRACE
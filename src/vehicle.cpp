@@ -0,0 +1,117 @@
+#include "vehicle.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ev_sim {
+
+using physics::kRadPerSecToRPM;
+
+VehicleCoefficients vehicleCoefficients(const VehicleParameters& params) {
+    const float radius = std::max(params.wheel_radius, 0.01f);
+    const float mass = std::max(params.mass, 1.0f);
+    const float effective_mass = mass + std::max(params.wheel_inertia, 0.0f) / (radius * radius);
+
+    // Slope angle from rise over run: cos carries the normal load, sin the pull
+    const float slope = 1.0f / std::sqrt(1.0f + params.grade * params.grade);
+    const float normal_load = mass * physics::kGravity * slope;
+
+    const float final_drive = std::max(params.final_drive, 1e-3f);
+
+    VehicleCoefficients coefficients;
+    coefficients.radius = radius;
+    coefficients.inv_radius = 1.0f / radius;
+    coefficients.inv_mass = 1.0f / effective_mass;
+    coefficients.constant_force = std::max(params.rolling_resistance, 0.0f) * normal_load +
+                                  mass * physics::kGravity * params.grade * slope;
+    coefficients.aero_coefficient = 0.5f * std::max(params.air_density, 0.0f) * std::max(params.drag_area, 0.0f);
+    coefficients.inv_final_drive = 1.0f / final_drive;
+    coefficients.output_rpm_per_speed = final_drive / radius * kRadPerSecToRPM;
+    coefficients.speed_per_output_rpm = 1.0f / coefficients.output_rpm_per_speed;
+    return coefficients;
+}
+
+Vehicle::Vehicle(const VehicleParameters& params)
+    : params_(params)
+    , coefficients_(vehicleCoefficients(params))
+    , speed_(0.0f)    // Starts at rest
+    , brake_torque_(0.0f)
+{
+    params_.final_drive = std::max(params_.final_drive, 1e-3f);
+}
+
+void Vehicle::step(float wheel_torque, float dt) {
+    // Braking only ever brings the speed to zero, like the road load's constant part
+    const float constant_force = coefficients_.constant_force + brake_torque_ * coefficients_.inv_radius;
+    speed_ = physics::vehicleSpeedStep(speed_, wheel_torque, coefficients_.inv_radius, coefficients_.inv_mass,
+                                       constant_force, coefficients_.aero_coefficient, dt);
+}
+
+void Vehicle::coast(double duration, double dt) {
+    if (dt <= 0.0) {
+        return;
+    }
+    const long steps = std::lround(duration / dt);
+    for (long i = 0; i < steps && (speed_ > 0.0f || coefficients_.constant_force < 0.0f); i++) {
+        step(0.0f, static_cast<float>(dt));
+    }
+}
+
+float Vehicle::getOutputInertia() const {
+    // Everything the wheels turn, through the final drive: (m r² + J_wheels) / fd²
+    const float radius = coefficients_.radius;
+    const float fd = params_.final_drive;
+    return radius * radius / (coefficients_.inv_mass * fd * fd);
+}
+
+void Vehicle::setGrade(float grade) {
+    params_.grade = grade;
+    coefficients_ = vehicleCoefficients(params_);
+}
+
+int VehicleBatch::add(const VehicleParameters& params) {
+    const VehicleCoefficients coefficients = vehicleCoefficients(params);
+    params_.push_back(params);
+    speed_.push_back(0.0f);
+    wheel_torque_.push_back(0.0f);
+    inv_radius_.push_back(coefficients.inv_radius);
+    inv_mass_.push_back(coefficients.inv_mass);
+    constant_force_.push_back(coefficients.constant_force);
+    aero_coefficient_.push_back(coefficients.aero_coefficient);
+    return size() - 1;
+}
+
+void VehicleBatch::clear() {
+    params_.clear();
+    speed_.clear();
+    wheel_torque_.clear();
+    inv_radius_.clear();
+    inv_mass_.clear();
+    constant_force_.clear();
+    aero_coefficient_.clear();
+}
+
+void VehicleBatch::step(float dt) {
+    EV_SIM_TRACE_ZONE("VehicleBatch::step", "physics");
+
+    // Unit-stride loop over separate arrays: Release builds vectorize it
+    // behind a one-off overlap check
+    const int count = size();
+    float* speed = speed_.data();
+    const float* wheel_torque = wheel_torque_.data();
+    const float* inv_radius = inv_radius_.data();
+    const float* inv_mass = inv_mass_.data();
+    const float* constant_force = constant_force_.data();
+    const float* aero_coefficient = aero_coefficient_.data();
+    for (int i = 0; i < count; i++) {
+        speed[i] = physics::vehicleSpeedStep(speed[i], wheel_torque[i], inv_radius[i], inv_mass[i],
+                                             constant_force[i], aero_coefficient[i], dt);
+    }
+}
+
+void VehicleBatch::setGrade(int index, float grade) {
+    params_[index].grade = grade;
+    constant_force_[index] = vehicleCoefficients(params_[index]).constant_force;
+}
+
+} // namespace ev_sim
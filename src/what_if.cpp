@@ -0,0 +1,73 @@
+#include "what_if.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ev_sim {
+
+std::vector<DriverCommand> applyVariant(const std::vector<DriverCommand>& inputs, const WhatIfVariant& variant,
+                                        float dt) {
+    std::vector<DriverCommand> shaped(inputs);
+    const float max_rise = variant.release_time > 0.0f ? 100.0f * dt / variant.release_time : 100.0f;
+    // Start from the first recorded position: the fork's pedal is not part of the state
+    float pedal = inputs.empty() ? 100.0f : inputs.front().clutch_pedal_percent;
+    for (DriverCommand& command : shaped) {
+        // Pressing is immediate; releasing (pedal going down) is rate limited
+        pedal = std::max(command.clutch_pedal_percent, pedal - max_rise);
+        command.clutch_pedal_percent = pedal;
+        command.throttle_percent = std::min(command.throttle_percent * variant.throttle_scale, 100.0f);
+    }
+    return shaped;
+}
+
+std::vector<WhatIfVariant> releaseTimeSweep(int count, float shortest, float longest) {
+    std::vector<WhatIfVariant> variants(static_cast<size_t>(std::max(count, 0)));
+    for (int i = 0; i < count; i++) {
+        WhatIfVariant& variant = variants[i];
+        variant.release_time = count > 1 ? shortest + (longest - shortest) * i / (count - 1) : shortest;
+        char label[32];
+        std::snprintf(label, sizeof(label), "release %.2f s", variant.release_time);
+        variant.label = label;
+    }
+    return variants;
+}
+
+std::vector<WhatIfResult> runWhatIf(const Drivetrain& base, const DrivetrainState& fork,
+                                    const std::vector<DriverCommand>& inputs,
+                                    const std::vector<WhatIfVariant>& variants, float dt, ThreadPool& pool) {
+    std::vector<WhatIfResult> results(variants.size());
+    pool.parallelFor(variants.size(), [&](size_t index) {
+        // Each job writes only its own drivetrain copy and result slot
+        const WhatIfVariant& variant = variants[index];
+        Drivetrain drivetrain(base);
+        drivetrain.restore(fork);
+        if (variant.configure) {
+            variant.configure(drivetrain);
+        }
+
+        WhatIfResult& result = results[index];
+        result.label = variant.label;
+        result.engine_rpm.reserve(inputs.size());
+        result.transmission_rpm.reserve(inputs.size());
+        result.clutch_pedal_percent.reserve(inputs.size());
+        for (const DriverCommand& command : applyVariant(inputs, variant, dt)) {
+            drivetrain.getGearbox().requestGear(command.gear);
+            drivetrain.getVehicle().setBrakeTorque(command.brake_torque);
+            drivetrain.step(command.throttle_percent, command.clutch_pedal_percent, dt);
+
+            const float engine_rpm = drivetrain.getEngineRPM();
+            const float transmission_rpm = drivetrain.getTransmissionRPM();
+            result.engine_rpm.push_back(engine_rpm);
+            result.transmission_rpm.push_back(transmission_rpm);
+            result.clutch_pedal_percent.push_back(command.clutch_pedal_percent);
+            if (drivetrain.getClutchEngagement() > 0.0f) {
+                result.max_slip_rpm = std::max(result.max_slip_rpm, std::fabs(engine_rpm - transmission_rpm));
+            }
+            result.grind_ticks += drivetrain.getGearbox().isGrinding() ? 1 : 0;
+        }
+        result.final_speed_kmh = drivetrain.getVehicle().getSpeedKmh();
+    });
+    return results;
+}
+
+} // namespace ev_sim
@@ -0,0 +1,183 @@
+#include "cycle_runner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace {
+
+/**
+ * Configurations swept by default: mass × final drive × shift speeds
+ */
+std::vector<ev_sim::CycleConfig> makeSweep() {
+    const float masses[] = { 1200.0f, 1430.0f, 1700.0f };
+    const float final_drives[] = { 3.6f, 4.1f, 4.6f };
+    const float upshift_rpms[] = { 2500.0f, 3500.0f };
+    std::vector<ev_sim::CycleConfig> configs;
+    for (float mass : masses) {
+        for (float final_drive : final_drives) {
+            for (float upshift_rpm : upshift_rpms) {
+                ev_sim::CycleConfig config;
+                config.vehicle.mass = mass;
+                config.vehicle.final_drive = final_drive;
+                config.driver.schedule.setUpshiftRPM(upshift_rpm);
+                char name[64];
+                std::snprintf(name, sizeof(name), "m=%.0f fd=%.1f up=%.0f", mass, final_drive, upshift_rpm);
+                config.name = name;
+                configs.push_back(config);
+            }
+        }
+    }
+    return configs;
+}
+
+void printUsage(const char* argv0) {
+    std::printf("Usage: %s [options]\n"
+                "  --cycle <file.csv>   Drive cycle, rows of time,speed_kmh (repeatable; default: built-in urban cycle)\n"
+                "  --threads <n>        Worker threads including the main one (default: one per hardware thread)\n"
+                "  --dt <seconds>       Physics step (default 0.01)\n"
+                "  --out <file.csv>     Write one row per cycle and configuration\n"
+                "  --serial             Also run single-threaded and report the speedup\n"
+                "  --coast-check        Only coast down in every gear and compare with the road load alone\n"
+                "Runs a mass x final drive x upshift RPM sweep of 18 configurations on every cycle.\n"
+                "Exit status: 0 ok, 1 coast-down check failed, 2 usage or I/O error\n", argv0);
+}
+
+/**
+ * Geared coast-down of the default configuration in every gear
+ * @return false if any gear slows the car more than the road load does
+ */
+bool runCoastCheck(const ev_sim::CycleOptions& options) {
+    // Driveline inertia may only soften the deceleration; 1% covers the step error
+    constexpr double kMaxExcess = 1.01;
+    const ev_sim::CycleConfig config;
+    const int gears = ev_sim::Gearbox(config.gearbox).getGearCount();
+    bool ok = true;
+    std::printf("%4s %10s %12s %12s %7s\n", "gear", "from km/h", "decel m/s2", "road m/s2", "ratio");
+    for (int gear = 1; gear <= gears; gear++) {
+        const ev_sim::CoastDownResult r = ev_sim::runCoastDown(config, options, gear);
+        const double ratio = r.deceleration / std::max(r.road_deceleration, 1e-9);
+        const bool pass = r.gear == gear && ratio <= kMaxExcess;
+        ok = ok && pass;
+        std::printf("%4d %10.1f %12.4f %12.4f %7.3f%s\n", gear, r.start_speed, r.deceleration, r.road_deceleration,
+                    ratio, pass ? "" : "  FAIL");
+    }
+    return ok;
+}
+
+/**
+ * Battery energy per distance driven
+ */
+double whPerKm(const ev_sim::CycleResult& result) {
+    return result.distance > 0.0 ? (result.battery_energy / 3600.0) / (result.distance / 1e3) : 0.0;
+}
+
+void writeResultsCsv(std::ostream& out, const std::vector<ev_sim::CycleResult>& results) {
+    out << "cycle,config,duration_s,distance_m,target_distance_m,engine_energy_kj,battery_energy_kj,wh_per_km,"
+           "final_soc,brake_energy_kj,slip_energy_kj,rms_speed_error_kmh,max_speed_error_kmh,shifts\n";
+    char line[384];
+    for (const ev_sim::CycleResult& r : results) {
+        std::snprintf(line, sizeof(line),
+                      "\"%s\",\"%s\",%.1f,%.1f,%.1f,%.2f,%.2f,%.1f,%.4f,%.2f,%.3f,%.3f,%.3f,%d\n",
+                      r.cycle.c_str(), r.config.c_str(), r.duration, r.distance, r.target_distance,
+                      r.engine_energy / 1e3, r.battery_energy / 1e3, whPerKm(r), r.final_soc,
+                      r.brake_energy / 1e3, r.slip_energy / 1e3, r.rms_speed_error, r.max_speed_error, r.shifts);
+        out << line;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> cycle_paths;
+    std::string out_path;
+    int threads = 0;
+    bool serial = false;
+    bool coast_check = false;
+    ev_sim::CycleOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--cycle") == 0 && has_value) {
+            cycle_paths.push_back(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+            threads = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(arg, "--dt") == 0 && has_value) {
+            options.dt = std::max(std::atof(argv[++i]), 1e-4);
+        } else if (std::strcmp(arg, "--out") == 0 && has_value) {
+            out_path = argv[++i];
+        } else if (std::strcmp(arg, "--serial") == 0) {
+            serial = true;
+        } else if (std::strcmp(arg, "--coast-check") == 0) {
+            coast_check = true;
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    if (coast_check) {
+        return runCoastCheck(options) ? 0 : 1;
+    }
+
+    // Each cycle is parsed once here and shared read-only by every worker
+    std::vector<ev_sim::DriveCycle> cycles;
+    if (cycle_paths.empty()) {
+        cycles.push_back(ev_sim::urbanCycle(4));
+    }
+    for (const std::string& path : cycle_paths) {
+        ev_sim::DriveCycle cycle;
+        std::string error;
+        if (!cycle.load(path, error)) {
+            std::fprintf(stderr, "Cannot load cycle %s: %s\n", path.c_str(), error.c_str());
+            return 2;
+        }
+        cycles.push_back(cycle);
+    }
+    const std::vector<ev_sim::CycleConfig> configs = makeSweep();
+
+    ev_sim::ThreadPool pool(threads);
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<ev_sim::CycleResult> results = ev_sim::runCycles(cycles, configs, options, pool);
+    const double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%-22s %-24s %9s %9s %9s %7s %9s %9s %8s %8s %6s\n", "cycle", "config", "dist km", "engine kJ",
+                "batt kJ", "Wh/km", "brake kJ", "slip kJ", "RMS km/h", "max km/h", "shifts");
+    for (const ev_sim::CycleResult& r : results) {
+        std::printf("%-22.22s %-24.24s %9.3f %9.1f %9.1f %7.1f %9.1f %9.2f %8.2f %8.2f %6d\n", r.cycle.c_str(),
+                    r.config.c_str(), r.distance / 1e3, r.engine_energy / 1e3, r.battery_energy / 1e3,
+                    whPerKm(r), r.brake_energy / 1e3, r.slip_energy / 1e3, r.rms_speed_error,
+                    r.max_speed_error, r.shifts);
+    }
+
+    double simulated = 0.0;
+    for (const ev_sim::CycleResult& r : results) {
+        simulated += r.duration;
+    }
+    std::printf("%zu runs, %.0f s simulated in %.1f ms on %d threads (%.0fx real time)\n", results.size(),
+                simulated, wall_ms, pool.threadCount(), simulated * 1e3 / std::max(wall_ms, 1e-6));
+
+    if (serial) {
+        ev_sim::ThreadPool single(1);
+        const auto serial_start = std::chrono::steady_clock::now();
+        ev_sim::runCycles(cycles, configs, options, single);
+        const double serial_ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - serial_start).count();
+        std::printf("Single-threaded: %.1f ms, %.2fx speedup\n", serial_ms, serial_ms / std::max(wall_ms, 1e-6));
+    }
+
+    if (!out_path.empty()) {
+        std::ofstream file(out_path);
+        if (!file) {
+            std::fprintf(stderr, "Cannot write %s\n", out_path.c_str());
+            return 2;
+        }
+        writeResultsCsv(file, results);
+        std::printf("Wrote %zu rows to %s\n", results.size(), out_path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "shift_optimizer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace {
+
+void printUsage(const char* argv0) {
+    std::printf("Usage: %s [options]\n"
+                "  --cycle <file.csv>   Energy cycle, rows of time,speed_kmh (repeatable; default: one ECE-15 cycle)\n"
+                "  --threads <n>        Worker threads including the main one (default: one per hardware thread)\n"
+                "  --weights <n>        Time/energy trade-offs searched (default 8)\n"
+                "  --evals <n>          Nelder-Mead evaluations per trade-off (default 120)\n"
+                "  --samples <n>        Initial Latin hypercube samples (default 32)\n"
+                "  --target <km/h>      Acceleration run end speed (default 100)\n"
+                "  --out <file.csv>     Write the Pareto front\n"
+                "  --all                Write every simulated schedule instead of only the front\n"
+                "Searches upshift RPMs and clutch release times for the default vehicle, trading\n"
+                "0-to-target time against cycle energy.\n"
+                "Exit status: 0 ok, 2 usage or I/O error\n", argv0);
+}
+
+std::string formatUpshifts(const ev_sim::ShiftSchedule& schedule, int upshifts, char separator) {
+    std::string out;
+    char value[16];
+    for (int i = 0; i < upshifts; i++) {
+        std::snprintf(value, sizeof(value), "%s%.0f", i > 0 ? std::string(1, separator).c_str() : "",
+                      schedule.upshift_rpm[i]);
+        out += value;
+    }
+    return out;
+}
+
+void writeCandidatesCsv(std::ostream& out, const std::vector<ev_sim::ShiftCandidate>& candidates, int upshifts) {
+    out << "acceleration_s,wh_per_km,rms_speed_error_kmh,feasible,launch_s,release_s";
+    for (int i = 0; i < upshifts; i++) {
+        out << ",upshift_" << i + 1 << "_rpm";
+    }
+    out << "\n";
+    char line[128];
+    for (const ev_sim::ShiftCandidate& c : candidates) {
+        std::snprintf(line, sizeof(line), "%.2f,%.2f,%.3f,%d,%.2f,%.2f,", c.acceleration_time, c.wh_per_km,
+                      c.rms_speed_error, c.feasible ? 1 : 0, c.schedule.launch_time, c.schedule.release_time);
+        out << line << formatUpshifts(c.schedule, upshifts, ',') << "\n";
+    }
+}
+
+void printCandidate(const char* label, const ev_sim::ShiftCandidate& c, int upshifts) {
+    std::printf("%-9s %8.2f %7.1f %8.2f %8.2f %9.2f  %s%s\n", label, c.acceleration_time, c.wh_per_km,
+                c.rms_speed_error, c.schedule.launch_time, c.schedule.release_time,
+                formatUpshifts(c.schedule, upshifts, '/').c_str(), c.feasible ? "" : "  (infeasible)");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> cycle_paths;
+    std::string out_path;
+    int threads = 0;
+    bool write_all = false;
+    ev_sim::ShiftOptimizerOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--cycle") == 0 && has_value) {
+            cycle_paths.push_back(argv[++i]);
+        } else if (std::strcmp(arg, "--threads") == 0 && has_value) {
+            threads = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(arg, "--weights") == 0 && has_value) {
+            options.weights = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(arg, "--evals") == 0 && has_value) {
+            options.evaluations_per_weight = std::max(std::atoi(argv[++i]), 0);
+        } else if (std::strcmp(arg, "--samples") == 0 && has_value) {
+            options.initial_samples = std::max(std::atoi(argv[++i]), 1);
+        } else if (std::strcmp(arg, "--target") == 0 && has_value) {
+            options.target_kmh = std::max(static_cast<float>(std::atof(argv[++i])), 1.0f);
+        } else if (std::strcmp(arg, "--out") == 0 && has_value) {
+            out_path = argv[++i];
+        } else if (std::strcmp(arg, "--all") == 0) {
+            write_all = true;
+        } else {
+            printUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+
+    std::vector<ev_sim::DriveCycle> cycles;
+    if (cycle_paths.empty()) {
+        cycles.push_back(ev_sim::urbanCycle(1));
+    }
+    for (const std::string& path : cycle_paths) {
+        ev_sim::DriveCycle cycle;
+        std::string error;
+        if (!cycle.load(path, error)) {
+            std::fprintf(stderr, "Cannot load cycle %s: %s\n", path.c_str(), error.c_str());
+            return 2;
+        }
+        cycles.push_back(cycle);
+    }
+
+    const ev_sim::CycleConfig base;
+    ev_sim::ShiftOptimizer optimizer(base, cycles, options);
+    const int upshifts = optimizer.dimensions() - 2;
+
+    ev_sim::ThreadPool pool(threads);
+    const auto start = std::chrono::steady_clock::now();
+    const ev_sim::ShiftOptimizerResult result = optimizer.run(pool);
+    const double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    char time_label[32];
+    std::snprintf(time_label, sizeof(time_label), "0-%.0f s", options.target_kmh);
+    std::printf("%-9s %8s %7s %8s %8s %9s  %s\n", "", time_label, "Wh/km", "RMS km/h", "launch s", "release s",
+                "upshift RPM");
+    printCandidate("baseline", result.baseline, upshifts);
+    for (const ev_sim::ShiftCandidate& c : result.front) {
+        printCandidate("front", c, upshifts);
+    }
+    std::printf("%zu evaluations: %zu simulated, %zu cache hits (%.0f%%); %zu on the front; %.1f ms on %d threads\n",
+                result.evaluations, result.simulations, result.cache_hits,
+                100.0 * result.cache_hits / std::max<size_t>(result.evaluations, 1), result.front.size(), wall_ms,
+                pool.threadCount());
+
+    if (!out_path.empty()) {
+        std::ofstream file(out_path);
+        if (!file) {
+            std::fprintf(stderr, "Cannot write %s\n", out_path.c_str());
+            return 2;
+        }
+        const std::vector<ev_sim::ShiftCandidate>& rows = write_all ? result.evaluated : result.front;
+        writeCandidatesCsv(file, rows, upshifts);
+        std::printf("Wrote %zu rows to %s\n", rows.size(), out_path.c_str());
+    }
+    return 0;
+}